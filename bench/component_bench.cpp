@@ -0,0 +1,178 @@
+// Component lookup benchmark: compares GameObject's slot-table lookup against
+// the previous linear dynamic_cast / string scan over owned components.
+//
+// Usage: component_bench [objects=10000] [rounds=200]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include "GameObject.h"
+#include "BodyComponent.h"
+#include "SpriteComponent.h"
+#include "ControllerComponent.h"
+#include "BehaviorComponent.h"
+
+namespace {
+
+// The old GameObject storage, kept here as the comparison baseline
+class LegacyGameObject {
+public:
+    void addComponent(std::unique_ptr<Component> component) {
+        components_.push_back(std::move(component));
+    }
+
+    template<typename T>
+    T* getComponent() {
+        for (auto& comp : components_) {
+            if (T* result = dynamic_cast<T*>(comp.get())) {
+                return result;
+            }
+        }
+        return nullptr;
+    }
+
+    Component* getComponent(const std::string& type) {
+        for (auto& comp : components_) {
+            // getType() used to return a std::string built on every call
+            if (std::string(comp->getType()) == type) {
+                return comp.get();
+            }
+        }
+        return nullptr;
+    }
+
+private:
+    std::vector<std::unique_ptr<Component>> components_;
+};
+
+using Clock = std::chrono::steady_clock;
+
+template<typename Fn>
+double timeNs(Fn&& fn) {
+    auto start = Clock::now();
+    fn();
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+void report(const char* label, double ns, long long lookups) {
+    std::printf("  %-34s %10.2f ms  %7.2f ns/lookup\n", label, ns / 1e6, ns / lookups);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int objectCount = argc > 1 ? std::atoi(argv[1]) : 10000;
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 200;
+    if (objectCount <= 0 || rounds <= 0) {
+        std::fprintf(stderr, "usage: %s [objects] [rounds]\n", argv[0]);
+        return 1;
+    }
+
+    // Acorn-shaped objects: Body + Sprite + ProjectileBehavior
+    std::vector<std::unique_ptr<GameObject>> objects;
+    std::vector<std::unique_ptr<LegacyGameObject>> legacyObjects;
+    objects.reserve(objectCount);
+    legacyObjects.reserve(objectCount);
+    for (int i = 0; i < objectCount; i++) {
+        auto obj = std::make_unique<GameObject>("Acorn");
+        obj->addComponent<BodyComponent>(static_cast<float>(i), 0.0f, 30.0f, 30.0f);
+        obj->addComponent<SpriteComponent>(TextureHandle(), nullptr, nullptr);
+        obj->addComponent<ProjectileBehavior>(600);
+        objects.push_back(std::move(obj));
+
+        auto legacy = std::make_unique<LegacyGameObject>();
+        legacy->addComponent(std::make_unique<BodyComponent>(static_cast<float>(i), 0.0f, 30.0f, 30.0f));
+        legacy->addComponent(std::make_unique<SpriteComponent>(TextureHandle(), nullptr, nullptr));
+        legacy->addComponent(std::make_unique<ProjectileBehavior>(600));
+        legacyObjects.push_back(std::move(legacy));
+    }
+
+    const long long lookups = static_cast<long long>(objectCount) * rounds * 3;
+    volatile float sink = 0.0f;
+    volatile int hits = 0;
+
+    std::printf("component_bench: %d objects x %d rounds (%lld lookups per case)\n",
+                objectCount, rounds, lookups);
+
+    // Typed lookups, as done per object per frame in Game::update and the behaviors
+    double legacyTyped = timeNs([&] {
+        for (int r = 0; r < rounds; r++) {
+            for (auto& obj : legacyObjects) {
+                auto* body = obj->getComponent<BodyComponent>();
+                auto* projectile = obj->getComponent<ProjectileBehavior>();
+                auto* sprite = obj->getComponent<SpriteComponent>();
+                sink = sink + body->getX();
+                hits = hits + (projectile != nullptr) + (sprite != nullptr);
+            }
+        }
+    });
+    double slotTyped = timeNs([&] {
+        for (int r = 0; r < rounds; r++) {
+            for (auto& obj : objects) {
+                auto* body = obj->getComponent<BodyComponent>();
+                auto* projectile = obj->getComponent<ProjectileBehavior>();
+                auto* sprite = obj->getComponent<SpriteComponent>();
+                sink = sink + body->getX();
+                hits = hits + (projectile != nullptr) + (sprite != nullptr);
+            }
+        }
+    });
+
+    // Lookups by type name
+    double legacyString = timeNs([&] {
+        for (int r = 0; r < rounds; r++) {
+            for (auto& obj : legacyObjects) {
+                hits = hits + (obj->getComponent("BodyComponent") != nullptr);
+                hits = hits + (obj->getComponent("ProjectileBehavior") != nullptr);
+                hits = hits + (obj->getComponent("SpriteComponent") != nullptr);
+            }
+        }
+    });
+    double slotString = timeNs([&] {
+        for (int r = 0; r < rounds; r++) {
+            for (auto& obj : objects) {
+                hits = hits + (obj->getComponent("BodyComponent") != nullptr);
+                hits = hits + (obj->getComponent("ProjectileBehavior") != nullptr);
+                hits = hits + (obj->getComponent("SpriteComponent") != nullptr);
+            }
+        }
+    });
+
+    // "Has component" checks that miss (worst case for a linear scan)
+    double legacyHas = timeNs([&] {
+        for (int r = 0; r < rounds; r++) {
+            for (auto& obj : legacyObjects) {
+                hits = hits + (obj->getComponent<ControllerComponent>() != nullptr);
+                hits = hits + (obj->getComponent<BounceBehavior>() != nullptr);
+                hits = hits + (obj->getComponent<ProjectileBehavior>() != nullptr);
+            }
+        }
+    });
+    double slotHas = timeNs([&] {
+        for (int r = 0; r < rounds; r++) {
+            for (auto& obj : objects) {
+                hits = hits + obj->hasComponent<ControllerComponent>();
+                hits = hits + obj->hasComponent<BounceBehavior>();
+                hits = hits + obj->hasComponent<ProjectileBehavior>();
+            }
+        }
+    });
+
+    std::printf("typed getComponent<T>()\n");
+    report("dynamic_cast scan (old)", legacyTyped, lookups);
+    report("slot table (new)", slotTyped, lookups);
+    std::printf("getComponent(name)\n");
+    report("getType() string compare (old)", legacyString, lookups);
+    report("name -> type id + slot (new)", slotString, lookups);
+    std::printf("has component\n");
+    report("dynamic_cast scan (old)", legacyHas, lookups);
+    report("mask test (new)", slotHas, lookups);
+    std::printf("speedup: typed %.1fx, name %.1fx, has %.1fx\n",
+                legacyTyped / slotTyped, legacyString / slotString, legacyHas / slotHas);
+
+    return hits == 0 && sink == 0.0f ? 1 : 0;
+}
@@ -0,0 +1,156 @@
+// Headless physics throughput benchmark: steps PhysicsWorld with acorn-like
+// dynamic bodies and bouncing sensor targets, no window or textures needed.
+// Bodies use the same parameters as Game::spawnAcorn and BounceBehavior.
+//
+// Usage: physics_bench [acorns=1000] [targets=50] [substeps=4] [workers=1] [ticks=600]
+//        (workers 0 = one per hardware thread)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include "GameObject.h"
+#include "BodyComponent.h"
+#include "BehaviorComponent.h"
+#include "ComponentRegistry.h"
+#include "PhysicsWorld.h"
+#include "TaskSystem.h"
+
+namespace {
+
+// Game constants (see Game.h / assets/config.xml)
+constexpr int SCREEN_WIDTH = 800;
+constexpr int SCREEN_HEIGHT = 600;
+constexpr float TICK_DT = 1.0f / 60.0f;
+constexpr float ACORN_SIZE = 30.0f;
+constexpr float ACORN_SPEED = 400.0f;
+constexpr float TARGET_SIZE = 90.0f;
+
+float randomFloat(float lo, float hi) {
+    return lo + (hi - lo) * (static_cast<float>(std::rand()) / RAND_MAX);
+}
+
+// Same launch as Game::spawnAcorn: downward velocity plus spin
+void launchAcorn(BodyComponent& body, float x, float y) {
+    body.setPosition(x, y);
+    body.setVelocity(0.0f, ACORN_SPEED);
+    body.setRotation(0.0f);
+    b2Body_SetTransform(body.getPhysicsBodyId(), {x, y}, b2Rot_identity);
+    body.syncToPhysics();
+    b2Body_SetAngularVelocity(body.getPhysicsBodyId(), 3.0f);
+}
+
+double percentile(std::vector<double>& sorted, double p) {
+    size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int acornCount = argc > 1 ? std::atoi(argv[1]) : 1000;
+    int targetCount = argc > 2 ? std::atoi(argv[2]) : 50;
+    int subSteps = argc > 3 ? std::atoi(argv[3]) : 4;
+    int workers = argc > 4 ? std::atoi(argv[4]) : 1;
+    int ticks = argc > 5 ? std::atoi(argv[5]) : 600;
+    if (acornCount < 0 || targetCount < 0 || subSteps <= 0 || workers < 0 || ticks <= 0) {
+        std::fprintf(stderr, "usage: %s [acorns] [targets] [substeps] [workers] [ticks]\n", argv[0]);
+        return 1;
+    }
+    std::srand(1);  // Same scene every run
+
+    // Declared before the world so it outlives it (as in Game)
+    std::unique_ptr<TaskSystem> taskSystem;
+    PhysicsWorld world(0.0f, 400.0f);
+    if (workers != 1) {
+        taskSystem = std::make_unique<TaskSystem>(workers);
+        world.setTaskSystem(taskSystem.get());
+    }
+
+    // Count events like Game::handleContacts would receive them
+    long long contactEvents = 0;
+    world.setContactCallback([&contactEvents](const std::vector<ContactEvent>& events) {
+        contactEvents += static_cast<long long>(events.size());
+    });
+
+    auto& registry = ComponentRegistry::instance();
+    registry.pool<BodyComponent>().reserve(acornCount + targetCount);
+    registry.pool<BounceBehavior>().reserve(targetCount);
+
+    // Targets: kinematic sensors bouncing around the bottom half, like the leaf
+    std::vector<std::unique_ptr<GameObject>> objects;
+    objects.reserve(acornCount + targetCount);
+    for (int i = 0; i < targetCount; i++) {
+        auto target = std::make_unique<GameObject>("Leaf");
+        target->setTag(ObjectTag::Leaf);
+        auto* body = target->addComponent<BodyComponent>(
+            randomFloat(0.0f, SCREEN_WIDTH - TARGET_SIZE),
+            randomFloat(SCREEN_HEIGHT / 2.0f, SCREEN_HEIGHT - TARGET_SIZE),
+            TARGET_SIZE, TARGET_SIZE);
+        body->setVelocity((std::rand() % 2 == 0 ? 1 : -1) * randomFloat(80.0f, 120.0f),
+                          (std::rand() % 2 == 0 ? 1 : -1) * randomFloat(60.0f, 100.0f));
+        body->createSensorBody(&world);
+        target->addComponent<BounceBehavior>(SCREEN_WIDTH, SCREEN_HEIGHT);
+        objects.push_back(std::move(target));
+    }
+
+    // Acorns: dynamic bodies with the game's restitution, relaunched from the
+    // top once they leave the screen so the body count stays constant
+    std::vector<BodyComponent*> acornBodies;
+    for (int i = 0; i < acornCount; i++) {
+        auto acorn = std::make_unique<GameObject>("Acorn");
+        acorn->setTag(ObjectTag::Acorn);
+        acorn->addComponent<BodyComponent>(0.0f, 0.0f, ACORN_SIZE, ACORN_SIZE);
+        objects.push_back(std::move(acorn));
+    }
+    for (size_t i = targetCount; i < objects.size(); i++) {
+        // Pointers taken after every body exists: the pool may move components on growth
+        auto* body = objects[i]->getComponent<BodyComponent>();
+        body->createPhysicsBody(&world, b2_dynamicBody, 0.15f);
+        launchAcorn(*body, randomFloat(0.0f, SCREEN_WIDTH - ACORN_SIZE), randomFloat(-SCREEN_HEIGHT, 0.0f));
+        acornBodies.push_back(body);
+    }
+
+    std::printf("physics_bench: %d acorns, %d targets, %d substeps, %d workers, %d ticks\n",
+                acornCount, targetCount, subSteps, world.getWorkerCount(), ticks);
+
+    using Clock = std::chrono::steady_clock;
+    std::vector<double> stepMicros;
+    stepMicros.reserve(ticks);
+    long long syncedBodies = 0;
+    long long relaunched = 0;
+
+    auto runStart = Clock::now();
+    for (int tick = 0; tick < ticks; tick++) {
+        auto stepStart = Clock::now();
+        world.step(TICK_DT, subSteps);
+        stepMicros.push_back(std::chrono::duration<double, std::micro>(Clock::now() - stepStart).count());
+        syncedBodies += world.getLastSyncCount();
+
+        // Game-side work that runs alongside every step
+        registry.updateAll<BounceBehavior>(TICK_DT);
+        for (BodyComponent* body : acornBodies) {
+            if (body->getY() > SCREEN_HEIGHT) {
+                launchAcorn(*body, randomFloat(0.0f, SCREEN_WIDTH - ACORN_SIZE), -ACORN_SIZE);
+                relaunched++;
+            }
+        }
+    }
+    double runSeconds = std::chrono::duration<double>(Clock::now() - runStart).count();
+
+    double stepSeconds = 0.0;
+    for (double us : stepMicros) stepSeconds += us * 1e-6;
+    std::sort(stepMicros.begin(), stepMicros.end());
+
+    int bodyCount = acornCount + targetCount;
+    std::printf("  steps/sec        %10.1f  (%.1f with game-side work)\n", ticks / stepSeconds, ticks / runSeconds);
+    std::printf("  step p50         %10.1f us\n", percentile(stepMicros, 0.50));
+    std::printf("  step p99         %10.1f us\n", percentile(stepMicros, 0.99));
+    std::printf("  step max         %10.1f us\n", stepMicros.back());
+    std::printf("  bodies/sec       %10.3g  (%d bodies stepped per tick)\n", bodyCount * ticks / stepSeconds, bodyCount);
+    std::printf("  synced/step      %10.1f\n", static_cast<double>(syncedBodies) / ticks);
+    std::printf("  contact events   %10lld  (%lld acorns relaunched)\n", contactEvents, relaunched);
+    return 0;
+}
@@ -0,0 +1,167 @@
+// Render benchmark: draws a scripted scene of N sprites (from the game's
+// texture atlas) plus text lines for K frames through Graphics, headless by
+// default (SDL dummy driver + software renderer), and reports frames/sec and
+// per-phase timings. The scene depends only on the frame number, so PNG dumps
+// of the same frame are comparable across runs (golden-image checks).
+//
+// Usage: render_bench [sprites=2000] [textLines=20] [frames=300]
+//                     [--window] [--font path.ttf] [--png dir]
+//        --png writes frames 0, K/2 and K-1 as dir/frame_NNNN.png
+// Run from the build directory (it loads assets/ like the game).
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "Graphics.h"
+
+namespace {
+
+constexpr int SCREEN_WIDTH = 800;
+constexpr int SCREEN_HEIGHT = 600;
+constexpr int FONT_SIZE = 24;
+
+struct SpriteKind {
+    const char* name;
+    float size;  // Display size from assets/textures.xml
+};
+constexpr SpriteKind KINDS[] = {{"acorn", 30.0f}, {"leaf", 90.0f}, {"SQRL", 80.0f}, {"RBIRD", 60.0f}};
+
+double percentile(std::vector<double>& sorted, double p) {
+    size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<const char*> positional;
+    bool headless = true;
+    std::string fontPath;
+    std::string pngDir;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--window") == 0) {
+            headless = false;
+        } else if (std::strcmp(argv[i], "--font") == 0 && i + 1 < argc) {
+            fontPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--png") == 0 && i + 1 < argc) {
+            pngDir = argv[++i];
+        } else {
+            positional.push_back(argv[i]);
+        }
+    }
+    int spriteCount = positional.size() > 0 ? std::atoi(positional[0]) : 2000;
+    int textLines = positional.size() > 1 ? std::atoi(positional[1]) : 20;
+    int frames = positional.size() > 2 ? std::atoi(positional[2]) : 300;
+    if (spriteCount < 0 || textLines < 0 || frames <= 0 || positional.size() > 3) {
+        std::fprintf(stderr, "usage: %s [sprites] [textLines] [frames] [--window] [--font path.ttf] [--png dir]\n", argv[0]);
+        return 1;
+    }
+
+    Graphics graphics;
+    if (!graphics.init("render_bench", SCREEN_WIDTH, SCREEN_HEIGHT, headless)) {
+        return 1;
+    }
+    graphics.setVSync(false);  // Measure rendering, not the display
+
+    graphics.loadTextureManifest("assets/textures.xml");
+    graphics.loadTextureFolder("assets");
+    if (!graphics.buildAtlas()) {
+        std::fprintf(stderr, "render_bench: failed to build the texture atlas (run from the build directory)\n");
+        return 1;
+    }
+    TextureHandle textures[std::size(KINDS)];
+    for (size_t k = 0; k < std::size(KINDS); k++) {
+        textures[k] = graphics.findTexture(KINDS[k].name);
+        if (!graphics.getRegion(textures[k]).texture) {
+            std::fprintf(stderr, "render_bench: missing texture %s\n", KINDS[k].name);
+            return 1;
+        }
+    }
+    if (fontPath.empty()) fontPath = Graphics::findSystemFont();
+    if (textLines > 0 && (fontPath.empty() || !graphics.loadFont(fontPath, FONT_SIZE))) {
+        std::fprintf(stderr, "render_bench: no font (pass --font path.ttf), text lines skipped\n");
+        textLines = 0;
+    }
+
+    std::printf("render_bench: %d sprites, %d text lines, %d frames, %s\n",
+                spriteCount, textLines, frames, headless ? "headless software renderer" : "window");
+
+    using Clock = std::chrono::steady_clock;
+    auto millis = [](Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); };
+    std::vector<double> frameMs;
+    frameMs.reserve(frames);
+    double sceneMs = 0.0, textMs = 0.0, presentMs = 0.0;
+    int pngsWritten = 0;
+    int maxSpriteCalls = 0;
+    char line[64];
+
+    auto runStart = Clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        auto frameStart = Clock::now();
+
+        // Scene: background plus sprites on Lissajous paths, spinning
+        graphics.drawFilledRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 135, 206, 235, 255);
+        graphics.drawFilledRect(0, 110, SCREEN_WIDTH, 20, 139, 69, 19, 255);
+        for (int i = 0; i < spriteCount; i++) {
+            const SpriteKind& kind = KINDS[i % std::size(KINDS)];
+            float x = SCREEN_WIDTH * 0.5f + 380.0f * std::sin(0.37f * i + frame * 0.011f * (1 + i % 3));
+            float y = SCREEN_HEIGHT * 0.5f + 280.0f * std::cos(0.53f * i + frame * 0.017f);
+            float rotation = frame * 0.05f + 0.1f * i;
+            graphics.drawSprite(textures[i % std::size(KINDS)], x - kind.size * 0.5f, y - kind.size * 0.5f,
+                                kind.size, kind.size, rotation);
+        }
+        auto sceneEnd = Clock::now();
+
+        // Text: changing every frame, like a HUD counter
+        for (int i = 0; i < textLines; i++) {
+            std::snprintf(line, sizeof(line), "Line %d  frame %d  points %d", i, frame, (frame * 7 + i) % 100);
+            graphics.drawText(line, 10 + (i % 2) * 400, 10 + (i / 2) * 28 % (SCREEN_HEIGHT - 30));
+        }
+        auto textEnd = Clock::now();
+
+        // Draw the queued primitives, sprites and text (timed as present)
+        graphics.flush();
+        auto flushEnd = Clock::now();
+
+        // Golden images: only the read-back and PNG write are left untimed
+        if (!pngDir.empty() && (frame == 0 || frame == frames / 2 || frame == frames - 1)) {
+            std::snprintf(line, sizeof(line), "/frame_%04d.png", frame);
+            if (graphics.saveScreenshot(pngDir + line)) pngsWritten++;
+        }
+        auto presentStart = Clock::now();
+        graphics.present();
+        auto frameEnd = Clock::now();
+
+        sceneMs += millis(sceneEnd - frameStart);
+        textMs += millis(textEnd - sceneEnd);
+        presentMs += millis((flushEnd - textEnd) + (frameEnd - presentStart));
+        frameMs.push_back(millis((frameEnd - frameStart) - (presentStart - flushEnd)));
+        maxSpriteCalls = std::max(maxSpriteCalls, graphics.getSpriteStats().frameDrawCalls);
+    }
+    double runSeconds = std::chrono::duration<double>(Clock::now() - runStart).count();
+
+    double totalMs = 0.0;
+    for (double ms : frameMs) totalMs += ms;
+    std::sort(frameMs.begin(), frameMs.end());
+
+    std::printf("  frames/sec       %10.1f  (%.1f including PNG dumps)\n", frames * 1000.0 / totalMs, frames / runSeconds);
+    std::printf("  frame p50        %10.3f ms\n", percentile(frameMs, 0.50));
+    std::printf("  frame p99        %10.3f ms\n", percentile(frameMs, 0.99));
+    std::printf("  frame max        %10.3f ms\n", frameMs.back());
+    std::printf("  scene (queue)    %10.3f ms/frame\n", sceneMs / frames);
+    std::printf("  text (layout)    %10.3f ms/frame\n", textMs / frames);
+    std::printf("  present (draw)   %10.3f ms/frame\n", presentMs / frames);
+    std::printf("  sprite calls     %10d  max per frame\n", maxSpriteCalls);
+    if (!pngDir.empty()) {
+        std::printf("  PNGs written     %10d  (to %s)\n", pngsWritten, pngDir.c_str());
+    }
+
+    graphics.shutdown();
+    return 0;
+}
@@ -0,0 +1,193 @@
+// Spawn-rate benchmark: creates and destroys objects through ObjectFactory's
+// prototypes (loaded from assets/objects.xml) and through the previous
+// hand-coded path (std::function creators looked up by type name, textures
+// looked up by name per spawn), and reports spawns/sec for each.
+//
+// Usage: spawn_bench [objects=10000] [rounds=50] [--physics]
+//        --physics also creates the Box2D bodies the prototypes ask for
+// Run from the build directory (it loads assets/objects.xml like the game).
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "GameObject.h"
+#include "BodyComponent.h"
+#include "SpriteComponent.h"
+#include "ControllerComponent.h"
+#include "BehaviorComponent.h"
+#include "ObjectFactory.h"
+#include "PhysicsWorld.h"
+#include "TextureAtlas.h"
+
+namespace {
+
+constexpr int SCREEN_WIDTH = 800;
+constexpr int SCREEN_HEIGHT = 600;
+
+// The old creation path, kept here as the comparison baseline: what
+// Game::registerObjectTypes used to register for every type
+struct LegacyParams {
+    float x = 0, y = 0;
+    float width = 0, height = 0;
+    float velocityX = 0, velocityY = 0;
+    float speed = 0;
+};
+using LegacyCreate = std::function<std::unique_ptr<GameObject>(const LegacyParams&)>;
+
+class LegacyFactory {
+public:
+    LegacyFactory(PhysicsWorld* world, const std::unordered_map<std::string, TextureHandle>& textures)
+        : world_(world), textures_(textures) {
+        add("Squirrel", ObjectTag::Squirrel, "SQRL", [](GameObject& obj, const LegacyParams& params) {
+            obj.addComponent<ControllerComponent>(params.speed, SCREEN_WIDTH);
+        }, BodyPhysics::Kinematic, 0.5f);
+        add("Leaf", ObjectTag::Leaf, "leaf", [](GameObject& obj, const LegacyParams&) {
+            obj.addComponent<BounceBehavior>(SCREEN_WIDTH, SCREEN_HEIGHT);
+        }, BodyPhysics::Sensor, 0.5f);
+        add("Acorn", ObjectTag::Acorn, "acorn", [](GameObject& obj, const LegacyParams&) {
+            obj.addComponent<ProjectileBehavior>(SCREEN_HEIGHT);
+        }, BodyPhysics::Dynamic, 0.15f);
+        add("RedBlock", ObjectTag::RedBlock, "RBIRD", [](GameObject& obj, const LegacyParams&) {
+            obj.addComponent<BounceBehavior>(SCREEN_WIDTH, SCREEN_HEIGHT);
+        }, BodyPhysics::Sensor, 0.5f);
+    }
+
+    std::unique_ptr<GameObject> create(const std::string& type, const LegacyParams& params) {
+        auto it = creators_.find(type);
+        return it != creators_.end() ? it->second(params) : nullptr;
+    }
+
+private:
+    template<typename Extra>
+    void add(const std::string& type, ObjectTag tag, std::string texture, Extra extra, BodyPhysics physics,
+             float restitution) {
+        creators_[type] = [this, type, tag, texture, extra, physics, restitution](const LegacyParams& params) {
+            auto obj = std::make_unique<GameObject>(type);
+            obj->setTag(tag);
+            auto* body = obj->addComponent<BodyComponent>(params.x, params.y, params.width, params.height);
+            body->setVelocity(params.velocityX, params.velocityY);
+            auto found = textures_.find(texture);  // Texture looked up by name per spawn
+            obj->addComponent<SpriteComponent>(found != textures_.end() ? found->second : TextureHandle(),
+                                               nullptr, nullptr);
+            extra(*obj, params);
+            if (world_) {
+                if (physics == BodyPhysics::Sensor) {
+                    body->createSensorBody(world_);
+                } else {
+                    body->createPhysicsBody(world_, physics == BodyPhysics::Dynamic ? b2_dynamicBody : b2_kinematicBody,
+                                            restitution);
+                }
+            }
+            return obj;
+        };
+    }
+
+    PhysicsWorld* world_;
+    const std::unordered_map<std::string, TextureHandle>& textures_;
+    std::unordered_map<std::string, LegacyCreate> creators_;
+};
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedNs(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+void report(const char* label, double spawnNs, double destroyNs, long long spawns) {
+    std::printf("  %-12s spawn %8.1f ns/object (%6.2f M/sec)   destroy %8.1f ns/object\n",
+                label, spawnNs / spawns, spawns * 1e3 / spawnNs, destroyNs / spawns);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<const char*> positional;
+    bool physics = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--physics") == 0) {
+            physics = true;
+        } else {
+            positional.push_back(argv[i]);
+        }
+    }
+    int objectCount = positional.size() > 0 ? std::atoi(positional[0]) : 10000;
+    int rounds = positional.size() > 1 ? std::atoi(positional[1]) : 50;
+    if (objectCount <= 0 || rounds <= 0 || positional.size() > 2) {
+        std::fprintf(stderr, "usage: %s [objects] [rounds] [--physics]\n", argv[0]);
+        return 1;
+    }
+
+    auto& factory = ObjectFactory::instance();
+    if (!factory.loadFromXML("assets/objects.xml")) {
+        std::fprintf(stderr, "spawn_bench: cannot load assets/objects.xml (run from the build directory)\n");
+        return 1;
+    }
+    PhysicsWorld world(0.0f, 400.0f);
+    PhysicsWorld* worldPtr = physics ? &world : nullptr;
+    factory.setWorld(worldPtr, nullptr, SCREEN_WIDTH, SCREEN_HEIGHT);
+
+    // Every type in turn, like a level setup plus a stream of shots
+    const char* const TYPES[] = {"Squirrel", "Leaf", "Acorn", "RedBlock"};
+    std::vector<ObjectFactory::PrototypeId> ids;
+    std::vector<LegacyParams> legacyParams;
+    for (const char* type : TYPES) {
+        ObjectFactory::PrototypeId id = factory.findPrototype(type);
+        const ObjectPrototype* prototype = factory.getPrototype(id);
+        if (!prototype) return 1;
+        ids.push_back(id);
+        factory.reserve(id, static_cast<size_t>(objectCount));
+        const ObjectPrototype::Body& body = prototype->body;
+        legacyParams.push_back({body.x, body.y, body.width, body.height, body.velocityX, body.velocityY, prototype->speed});
+    }
+    std::unordered_map<std::string, TextureHandle> textures = {
+        {"SQRL", {}}, {"leaf", {}}, {"acorn", {}}, {"RBIRD", {}}, {"blocks", {}}
+    };
+    LegacyFactory legacy(worldPtr, textures);
+
+    std::printf("spawn_bench: %d objects x %d rounds, %s\n", objectCount, rounds,
+                physics ? "with physics bodies" : "no physics bodies");
+
+    std::vector<std::unique_ptr<GameObject>> legacyObjects;
+    std::vector<ObjectPtr> objects;
+    legacyObjects.reserve(objectCount);
+    objects.reserve(objectCount);
+    double legacySpawn = 0.0, legacyDestroy = 0.0;
+    double prototypeSpawn = 0.0, prototypeDestroy = 0.0;
+    volatile int alive = 0;
+
+    // Alternate the two paths each round so both see the same pool state
+    for (int r = 0; r < rounds; r++) {
+        auto start = Clock::now();
+        for (int i = 0; i < objectCount; i++) {
+            size_t kind = static_cast<size_t>(i) % ids.size();
+            legacyObjects.push_back(legacy.create(TYPES[kind], legacyParams[kind]));
+        }
+        legacySpawn += elapsedNs(start);
+        alive = alive + static_cast<int>(legacyObjects.size());
+        start = Clock::now();
+        legacyObjects.clear();
+        legacyDestroy += elapsedNs(start);
+
+        start = Clock::now();
+        for (int i = 0; i < objectCount; i++) {
+            objects.push_back(factory.create(ids[static_cast<size_t>(i) % ids.size()]));
+        }
+        prototypeSpawn += elapsedNs(start);
+        alive = alive + static_cast<int>(objects.size());
+        start = Clock::now();
+        objects.clear();
+        prototypeDestroy += elapsedNs(start);
+    }
+
+    long long spawns = static_cast<long long>(objectCount) * rounds;
+    report("by name", legacySpawn, legacyDestroy, spawns);
+    report("prototype", prototypeSpawn, prototypeDestroy, spawns);
+    std::printf("  speedup      %8.2fx spawn\n", legacySpawn / prototypeSpawn);
+    return 0;
+}
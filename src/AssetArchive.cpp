@@ -0,0 +1,150 @@
+#include "AssetArchive.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Maps a whole file read-only. The file and mapping handles can be closed
+// straight away; the view keeps the mapping alive until it is unmapped.
+const uint8_t* mapFile(const std::string& path, size_t& size) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return nullptr;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return nullptr;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping) return nullptr;
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view) return nullptr;
+    size = static_cast<size_t>(fileSize.QuadPart);
+    return static_cast<const uint8_t*>(view);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) return nullptr;
+    size = static_cast<size_t>(info.st_size);
+    return static_cast<const uint8_t*>(view);
+#endif
+}
+
+void unmapFile(const uint8_t* data, size_t size) {
+#ifdef _WIN32
+    (void)size;
+    UnmapViewOfFile(data);
+#else
+    munmap(const_cast<uint8_t*>(data), size);
+#endif
+}
+
+} // namespace
+
+AssetArchive::~AssetArchive() {
+    close();
+}
+
+bool AssetArchive::open(const std::string& path) {
+    close();
+    data_ = mapFile(path, size_);
+    if (!data_) return false;  // Missing archive is normal: loose files are used instead
+
+    Format::Header header;
+    bool ok = size_ >= sizeof(header);
+    if (ok) {
+        std::memcpy(&header, data_, sizeof(header));
+        ok = std::memcmp(header.magic, Format::MAGIC, sizeof(header.magic)) == 0 &&
+             header.version == Format::VERSION &&
+             header.tocOffset <= size_ &&
+             header.entryCount <= (size_ - header.tocOffset) / sizeof(Format::TocEntry);
+    }
+    for (uint32_t i = 0; ok && i < header.entryCount; i++) {
+        Format::TocEntry toc;
+        std::memcpy(&toc, data_ + header.tocOffset + i * sizeof(toc), sizeof(toc));
+        toc.name[Format::NAME_SIZE - 1] = '\0';
+        ok = toc.offset <= size_ && toc.size <= size_ - toc.offset;
+        if (ok) {
+            entries_.push_back({toc.name, toc.type, data_ + toc.offset, static_cast<size_t>(toc.size)});
+        }
+    }
+    if (!ok) {
+        std::cerr << "Ignoring " << path << ": not a valid version " << Format::VERSION << " asset archive\n";
+        close();
+        return false;
+    }
+    return true;
+}
+
+void AssetArchive::close() {
+    if (data_) {
+        unmapFile(data_, size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    entries_.clear();
+}
+
+const AssetArchive::Entry* AssetArchive::find(const std::string& name) const {
+    for (const Entry& entry : entries_) {
+        if (entry.name == name) return &entry;
+    }
+    return nullptr;
+}
+
+void AssetArchiveWriter::add(const std::string& name, AssetArchiveFormat::EntryType type,
+                             const std::vector<uint8_t>& payload) {
+    // Align every payload so pixel rows and records can be read in place
+    size_t offset = sizeof(AssetArchiveFormat::Header) + payloads_.size();
+    size_t padding = (AssetArchiveFormat::ALIGNMENT - offset % AssetArchiveFormat::ALIGNMENT) % AssetArchiveFormat::ALIGNMENT;
+    payloads_.resize(payloads_.size() + padding, 0);
+
+    AssetArchiveFormat::TocEntry entry = {};
+    std::strncpy(entry.name, name.c_str(), AssetArchiveFormat::NAME_SIZE - 1);
+    entry.type = type;
+    entry.offset = offset + padding;
+    entry.size = payload.size();
+    toc_.push_back(entry);
+    payloads_.insert(payloads_.end(), payload.begin(), payload.end());
+}
+
+bool AssetArchiveWriter::write(const std::string& path) const {
+    AssetArchiveFormat::Header header = {};
+    std::memcpy(header.magic, AssetArchiveFormat::MAGIC, sizeof(header.magic));
+    header.version = AssetArchiveFormat::VERSION;
+    header.entryCount = static_cast<uint32_t>(toc_.size());
+    header.tocOffset = sizeof(header) + payloads_.size();
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Failed to create " << path << "\n";
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(payloads_.data()), static_cast<std::streamsize>(payloads_.size()));
+    out.write(reinterpret_cast<const char*>(toc_.data()), static_cast<std::streamsize>(toc_.size() * sizeof(AssetArchiveFormat::TocEntry)));
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Packed asset archive (assets/assets.pak), written at build time by
+// tools/asset_packer and memory-mapped at startup. Everything in it is
+// already in the form the game uses: atlas pages as ARGB8888 pixels ready
+// for SDL_UpdateTexture, config and object definitions as binary records.
+//
+// Layout (native byte order; the packer runs on the machine it builds for):
+//   Header | entry payloads, each 16-byte aligned | table of contents
+struct AssetArchiveFormat {
+    static constexpr char MAGIC[4] = {'S', 'Q', 'P', 'K'};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t ALIGNMENT = 16;
+    static constexpr size_t NAME_SIZE = 48;
+
+    enum class EntryType : uint32_t {
+        AtlasPage = 1,          // AtlasPageHeader, regions, then pixels
+        Config = 2,             // GameConfig::write
+        ObjectDefinitions = 3,  // ObjectFactory::writeBinary
+    };
+
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t reserved;
+        uint64_t tocOffset;
+    };
+    struct TocEntry {
+        char name[NAME_SIZE];  // Null-terminated
+        EntryType type;
+        uint32_t reserved;
+        uint64_t offset;       // From the start of the file
+        uint64_t size;
+    };
+
+    struct AtlasPageHeader {
+        uint32_t width, height;
+        uint32_t pitch;         // Bytes per row
+        uint32_t format;        // SDL_PIXELFORMAT_ARGB8888
+        uint32_t regionCount;
+        uint32_t pixelOffset;   // From the start of this entry, aligned
+    };
+    struct AtlasRegion {
+        char name[NAME_SIZE];
+        int32_t x, y, w, h;
+        uint32_t sourceBytes;   // 32-bit size of the image before mip reduction
+        uint32_t reserved;
+    };
+};
+
+// Read-only view of a memory-mapped archive. Payload pointers stay valid
+// until close().
+class AssetArchive {
+public:
+    using Format = AssetArchiveFormat;
+
+    AssetArchive() = default;
+    ~AssetArchive();
+    AssetArchive(const AssetArchive&) = delete;
+    AssetArchive& operator=(const AssetArchive&) = delete;
+
+    // Maps the file and validates the header and table of contents
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return data_ != nullptr; }
+
+    struct Entry {
+        std::string name;
+        Format::EntryType type;
+        const uint8_t* data;
+        size_t size;
+    };
+    const std::vector<Entry>& getEntries() const { return entries_; }
+    const Entry* find(const std::string& name) const;
+    size_t getSize() const { return size_; }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    std::vector<Entry> entries_;
+};
+
+// Builds an archive in memory and writes it out (used by the packer)
+class AssetArchiveWriter {
+public:
+    void add(const std::string& name, AssetArchiveFormat::EntryType type, const std::vector<uint8_t>& payload);
+    bool write(const std::string& path) const;
+    size_t getEntryCount() const { return toc_.size(); }
+
+private:
+    std::vector<uint8_t> payloads_;  // Everything after the header
+    std::vector<AssetArchiveFormat::TocEntry> toc_;
+};
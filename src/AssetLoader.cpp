@@ -0,0 +1,188 @@
+#include "AssetLoader.h"
+#include "MipGenerator.h"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <thread>
+
+AssetLoader::AssetLoader(Graphics& graphics, int workerCount)
+    : graphics_(graphics) {
+    if (workerCount <= 0) {
+        workerCount = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    // Worker 0 is normally the waiting thread; the render thread only polls,
+    // so add one so that workerCount threads actually decode
+    tasks_ = std::make_unique<TaskSystem>(std::max(workerCount, 1) + 1);
+}
+
+AssetLoader::~AssetLoader() {
+    // Queued jobs reference this loader; let them finish before tearing down
+    for (void* wave : {firstWave_, reduceWave_}) {
+        while (wave && !tasks_->tryWait(wave)) {
+            std::this_thread::yield();
+        }
+    }
+    for (Image& image : images_) {
+        if (image.surface) {
+            SDL_FreeSurface(image.surface);
+        }
+    }
+}
+
+void AssetLoader::addTextureManifest(const std::string& path) {
+    manifestPath_ = path;
+}
+
+int AssetLoader::addTextureFolder(const std::string& directory) {
+    std::error_code error;
+    int added = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".png") continue;
+        Image image;
+        image.name = entry.path().stem().string();
+        image.path = entry.path().string();
+        images_.push_back(std::move(image));
+        added++;
+    }
+    if (error) {
+        std::cerr << "Failed to read " << directory << ": " << error.message() << "\n";
+    }
+    return added;
+}
+
+void AssetLoader::addTask(const std::string& name, std::function<bool()> work) {
+    extraTasks_.push_back({name, std::move(work)});
+}
+
+void AssetLoader::start() {
+    if (started_) return;
+    started_ = true;
+    startTime_ = Clock::now();
+
+    // Biggest files first, so the long decodes start right away
+    std::stable_sort(images_.begin(), images_.end(), [](const Image& a, const Image& b) {
+        std::error_code error;
+        return std::filesystem::file_size(a.path, error) > std::filesystem::file_size(b.path, error);
+    });
+
+    // Wave 1: item 0 is the manifest, then the extra tasks, then one decode per image
+    int itemCount = 1 + static_cast<int>(extraTasks_.size() + images_.size());
+    firstWave_ = tasks_->parallelFor(&AssetLoader::runFirstWave, itemCount, 1, this);
+}
+
+void AssetLoader::runFirstWave(int start, int end, uint32_t, void* context) {
+    auto* loader = static_cast<AssetLoader*>(context);
+    int taskCount = static_cast<int>(loader->extraTasks_.size());
+    for (int item = start; item < end; item++) {
+        auto itemStart = Clock::now();
+        if (item == 0) {
+            if (!loader->manifestPath_.empty()) {
+                loader->manifestOk_ = Graphics::parseTextureManifest(loader->manifestPath_, loader->displaySizes_);
+            }
+            loader->manifestMs_ = std::chrono::duration<double, std::milli>(Clock::now() - itemStart).count();
+        } else if (item <= taskCount) {
+            Task& task = loader->extraTasks_[item - 1];
+            task.ok = task.work();
+            task.ms = std::chrono::duration<double, std::milli>(Clock::now() - itemStart).count();
+        } else {
+            Image& image = loader->images_[item - 1 - taskCount];
+            image.surface = Graphics::decodeImage(image.path);
+            if (image.surface) {
+                image.decoded = true;
+                image.sourceW = image.surface->w;
+                image.sourceH = image.surface->h;
+            }
+            image.decodeMs = std::chrono::duration<double, std::milli>(Clock::now() - itemStart).count();
+        }
+        loader->completed_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void AssetLoader::runReduceWave(int start, int end, uint32_t, void* context) {
+    auto* loader = static_cast<AssetLoader*>(context);
+    for (int index = start; index < end; index++) {
+        Image& image = loader->images_[index];
+        auto reduceStart = Clock::now();
+        if (image.surface) {
+            for (const Graphics::TextureDisplaySize& size : loader->displaySizes_) {
+                if (size.name == image.name) {
+                    image.surface = reduceToDisplaySize(image.surface, std::max(size.width, 1),
+                                                        std::max(size.height, 1), &image.mipLevel);
+                    break;
+                }
+            }
+            image.width = image.surface->w;
+            image.height = image.surface->h;
+        }
+        image.reduceMs = std::chrono::duration<double, std::milli>(Clock::now() - reduceStart).count();
+        loader->completed_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool AssetLoader::poll() {
+    if (done_) return true;
+    if (!started_) return false;
+
+    // Wave 2 needs the manifest and every decoded surface
+    if (!reduceStarted_) {
+        if (!tasks_->tryWait(firstWave_)) return false;
+        firstWave_ = nullptr;
+        reduceStarted_ = true;
+        if (!images_.empty()) {
+            reduceWave_ = tasks_->parallelFor(&AssetLoader::runReduceWave, static_cast<int>(images_.size()), 1, this);
+        }
+    }
+    if (!tasks_->tryWait(reduceWave_)) return false;
+    reduceWave_ = nullptr;
+
+    // Everything is decoded: queue the images and upload the atlas here, on
+    // the thread that owns the renderer
+    bool ok = manifestOk_;
+    for (Image& image : images_) {
+        if (!image.surface) {
+            ok = false;
+            continue;
+        }
+        graphics_.addImage(image.name, image.surface, static_cast<size_t>(image.sourceW) * image.sourceH * 4);
+        image.surface = nullptr;  // The atlas owns it now
+    }
+    for (const Task& task : extraTasks_) {
+        ok = ok && task.ok;
+    }
+    auto atlasStart = Clock::now();
+    ok = graphics_.buildAtlas() && ok;
+    atlasMs_ = std::chrono::duration<double, std::milli>(Clock::now() - atlasStart).count();
+    totalMs_ = std::chrono::duration<double, std::milli>(Clock::now() - startTime_).count();
+
+    tasks_.reset();  // Join the workers; nothing else to do
+    done_ = true;
+    succeeded_ = ok;
+    return true;
+}
+
+float AssetLoader::getProgress() const {
+    if (done_) return 1.0f;
+    // Manifest, each task, each decode and each reduction, plus the upload
+    int total = 2 + static_cast<int>(extraTasks_.size() + 2 * images_.size());
+    return static_cast<float>(completed_.load(std::memory_order_relaxed)) / total;
+}
+
+void AssetLoader::printReport() const {
+    std::cout << "Assets loaded in " << totalMs_ << " ms (" << (succeeded_ ? "ok" : "with errors") << ")\n";
+    if (!manifestPath_.empty()) {
+        std::cout << "  " << manifestPath_ << ": parsed in " << manifestMs_ << " ms\n";
+    }
+    for (const Task& task : extraTasks_) {
+        std::cout << "  " << task.name << ": " << task.ms << " ms" << (task.ok ? "" : " (failed)") << "\n";
+    }
+    for (const Image& image : images_) {
+        std::cout << "  " << image.name << ": " << image.sourceW << "x" << image.sourceH
+                  << " decoded in " << image.decodeMs << " ms";
+        if (image.mipLevel > 0) {
+            std::cout << ", mip " << image.mipLevel << " (" << image.width << "x" << image.height
+                      << ") in " << image.reduceMs << " ms";
+        }
+        std::cout << (image.decoded ? "" : " (failed)") << "\n";
+    }
+    std::cout << "  atlas upload: " << atlasMs_ << " ms\n";
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <SDL.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Graphics.h"
+#include "TaskSystem.h"
+
+// Loads startup assets in the background so the window is responsive (and
+// the title screen shows) while images decode.
+//
+// Work runs on a private TaskSystem in two waves: first every PNG decode,
+// the texture manifest and any extra tasks (XML parsing) in parallel; then
+// the mip reductions, which need the manifest's display sizes. The render
+// thread calls poll() once per frame: it starts the second wave when the
+// first is done, hands finished images to Graphics and, once the last one
+// is in, uploads the atlas. Per-asset timings are kept for printReport().
+class AssetLoader {
+public:
+    // workerCount 0 = one per hardware thread
+    explicit AssetLoader(Graphics& graphics, int workerCount = 0);
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    // Queue work before start()
+    void addTextureManifest(const std::string& path);
+    int addTextureFolder(const std::string& directory);  // Every PNG, named by file stem
+    void addTask(const std::string& name, std::function<bool()> work);  // Runs on a worker
+
+    void start();
+
+    // Render thread, once per frame. Returns true once everything is loaded
+    // and the atlas has been built.
+    bool poll();
+    bool isDone() const { return done_; }
+    bool succeeded() const { return succeeded_; }
+    float getProgress() const;  // 0..1
+
+    void printReport() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Image {
+        std::string name;
+        std::string path;
+        SDL_Surface* surface = nullptr;  // Owned until handed to Graphics
+        int sourceW = 0, sourceH = 0;
+        int width = 0, height = 0;       // After reduction
+        int mipLevel = 0;
+        double decodeMs = 0.0;
+        double reduceMs = 0.0;
+        bool decoded = false;
+    };
+    struct Task {
+        std::string name;
+        std::function<bool()> work;
+        bool ok = false;
+        double ms = 0.0;
+    };
+
+    static void runFirstWave(int start, int end, uint32_t workerIndex, void* context);
+    static void runReduceWave(int start, int end, uint32_t workerIndex, void* context);
+
+    Graphics& graphics_;
+    std::unique_ptr<TaskSystem> tasks_;
+    std::vector<Image> images_;
+    std::vector<Task> extraTasks_;
+    std::string manifestPath_;
+    std::vector<Graphics::TextureDisplaySize> displaySizes_;
+    bool manifestOk_ = true;
+    double manifestMs_ = 0.0;
+
+    void* firstWave_ = nullptr;
+    void* reduceWave_ = nullptr;
+    bool started_ = false;
+    bool reduceStarted_ = false;
+    bool done_ = false;
+    bool succeeded_ = false;
+    std::atomic<int> completed_{0};  // Images decoded+reduced plus tasks finished
+    Clock::time_point startTime_;
+    double atlasMs_ = 0.0;
+    double totalMs_ = 0.0;
+};
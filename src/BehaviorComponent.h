@@ -12,7 +12,8 @@ class BounceBehavior : public BehaviorComponent {
 public:
     BounceBehavior(int screenWidth, int screenHeight);
     
-    std::string getType() const override { return "BounceBehavior"; }
+    static constexpr ComponentType TYPE = ComponentType::BounceBehavior;
+    const char* getType() const override { return "BounceBehavior"; }
     void update(float dt) override;
 
 private:
@@ -25,10 +26,12 @@ class ProjectileBehavior : public BehaviorComponent {
 public:
     ProjectileBehavior(int screenHeight);
     
-    std::string getType() const override { return "ProjectileBehavior"; }
+    static constexpr ComponentType TYPE = ComponentType::ProjectileBehavior;
+    const char* getType() const override { return "ProjectileBehavior"; }
     void update(float dt) override;
     
     bool isOffScreen() const { return offScreen_; }
+    void reset() { offScreen_ = false; }  // Reuse from the projectile pool
 
 private:
     int screenHeight_;
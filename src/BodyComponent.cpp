@@ -2,13 +2,39 @@
 #include "PhysicsWorld.h"
 
 BodyComponent::BodyComponent(float x, float y, float w, float h)
-    : x_(x), y_(y), width_(w), height_(h) {
+    : x_(x), y_(y), width_(w), height_(h), prevX_(x), prevY_(y) {
+}
+
+BodyComponent::~BodyComponent() {
+    destroyPhysicsBody();
+}
+
+BodyComponent::BodyComponent(BodyComponent&& other) noexcept
+    : BodyComponent(static_cast<const BodyComponent&>(other)) {
+    other.physicsBodyId_ = b2_nullBodyId;
+    other.physicsWorld_ = nullptr;
+    if (B2_IS_NON_NULL(physicsBodyId_)) {
+        b2Body_SetUserData(physicsBodyId_, this);
+    }
+}
+
+BodyComponent& BodyComponent::operator=(BodyComponent&& other) noexcept {
+    if (this != &other) {
+        destroyPhysicsBody();
+        *this = static_cast<const BodyComponent&>(other);
+        other.physicsBodyId_ = b2_nullBodyId;
+        other.physicsWorld_ = nullptr;
+        if (B2_IS_NON_NULL(physicsBodyId_)) {
+            b2Body_SetUserData(physicsBodyId_, this);
+        }
+    }
+    return *this;
 }
 
 void BodyComponent::update(float dt) {
     if (B2_IS_NON_NULL(physicsBodyId_)) {
-        // If we have a physics body, sync from physics
-        syncFromPhysics();
+        // Physics bodies are synced in bulk by PhysicsWorld::step from Box2D
+        // move events, so there is nothing to do here
     } else {
         // Otherwise use simple velocity-based movement
         x_ += velocityX_ * dt;
@@ -16,6 +42,15 @@ void BodyComponent::update(float dt) {
     }
 }
 
+float BodyComponent::getInterpolatedRotation(float alpha) const {
+    // Blend along the shortest arc so spinning bodies don't flip at the +/-pi wrap
+    constexpr float PI = 3.14159265359f;
+    float delta = rotation_ - prevRotation_;
+    if (delta > PI) delta -= 2.0f * PI;
+    else if (delta < -PI) delta += 2.0f * PI;
+    return prevRotation_ + delta * alpha;
+}
+
 // BOX2D INTEGRATION: Create a physics body for this game object
 // Links the visual game object with Box2D physics simulation
 void BodyComponent::createPhysicsBody(PhysicsWorld* world, b2BodyType type, float restitution, float gravityScale, float linearDamping) {
@@ -23,6 +58,7 @@ void BodyComponent::createPhysicsBody(PhysicsWorld* world, b2BodyType type, floa
     if (!world || B2_IS_NON_NULL(physicsBodyId_)) return;
     
     physicsWorld_ = world;
+    bodyType_ = type;
     
     // Define the physics body properties
     b2BodyDef bodyDef = b2DefaultBodyDef();
@@ -44,6 +80,8 @@ void BodyComponent::createPhysicsBody(PhysicsWorld* world, b2BodyType type, floa
     shapeDef.density = 1.0f; // Mass per unit area
     shapeDef.material.friction = 0.3f; // Surface friction (0 = ice, 1 = rubber)
     shapeDef.material.restitution = restitution; // Bounciness (0 = no bounce, 1 = perfect bounce)
+    shapeDef.enableContactEvents = true; // Report begin/end touches (see PhysicsWorld::step)
+    shapeDef.enableSensorEvents = true; // Let target sensors detect this shape
     
     // Attach the shape to the body
     b2CreatePolygonShape(physicsBodyId_, &shapeDef, &boxShape);
@@ -53,6 +91,34 @@ void BodyComponent::createPhysicsBody(PhysicsWorld* world, b2BodyType type, floa
     b2Body_SetUserData(physicsBodyId_, this);
 }
 
+// BOX2D INTEGRATION: Create a kinematic body with a sensor shape for targets
+// Sensors never push anything; overlaps come back as sensor events after each
+// step, so hit detection uses Box2D's broadphase instead of manual AABB loops
+void BodyComponent::createSensorBody(PhysicsWorld* world) {
+    if (!world || B2_IS_NON_NULL(physicsBodyId_)) return;
+    
+    physicsWorld_ = world;
+    bodyType_ = b2_kinematicBody;
+    
+    // Kinematic: moved by its velocity, unaffected by forces and gravity
+    b2BodyDef bodyDef = b2DefaultBodyDef();
+    bodyDef.type = b2_kinematicBody;
+    bodyDef.position = {x_, y_};
+    bodyDef.linearVelocity = {velocityX_, velocityY_};
+    physicsBodyId_ = b2CreateBody(world->getWorldId(), &bodyDef);
+    
+    // Body origin is the sprite's top-left corner, so offset the box to cover the sprite
+    b2Polygon sensorBox = b2MakeOffsetBox(width_ / 2.0f, height_ / 2.0f,
+                                          {width_ / 2.0f, height_ / 2.0f}, b2Rot_identity);
+    
+    b2ShapeDef shapeDef = b2DefaultShapeDef();
+    shapeDef.isSensor = true;
+    shapeDef.enableSensorEvents = true;
+    b2CreatePolygonShape(physicsBodyId_, &shapeDef, &sensorBox);
+    
+    b2Body_SetUserData(physicsBodyId_, this);
+}
+
 void BodyComponent::destroyPhysicsBody() {
     if (B2_IS_NON_NULL(physicsBodyId_)) {
         b2DestroyBody(physicsBodyId_);
@@ -61,6 +127,15 @@ void BodyComponent::destroyPhysicsBody() {
     }
 }
 
+void BodyComponent::setPhysicsEnabled(bool enabled) {
+    if (B2_IS_NULL(physicsBodyId_) || b2Body_IsEnabled(physicsBodyId_) == enabled) return;
+    if (enabled) {
+        b2Body_Enable(physicsBodyId_);
+    } else {
+        b2Body_Disable(physicsBodyId_);
+    }
+}
+
 // BOX2D-SDL SYNC: Copy physics state to visual representation
 // Called each frame to keep the rendered sprite in sync with physics simulation
 void BodyComponent::syncFromPhysics() {
@@ -81,9 +156,66 @@ void BodyComponent::syncFromPhysics() {
     }
 }
 
+// BOX2D-SDL SYNC: Apply a transform reported in a Box2D body move event
+// Only bodies that actually moved get here; velocity is not mirrored for these
+void BodyComponent::applyPhysicsTransform(const b2Transform& transform) {
+    x_ = transform.p.x;
+    y_ = transform.p.y;
+    rotation_ = b2Rot_GetAngle(transform.q);
+}
+
 void BodyComponent::syncToPhysics() {
     if (B2_IS_NON_NULL(physicsBodyId_)) {
         b2Body_SetTransform(physicsBodyId_, {x_, y_}, b2Body_GetRotation(physicsBodyId_));
         b2Body_SetLinearVelocity(physicsBodyId_, {velocityX_, velocityY_});
     }
 }
+
+BodyComponent::State BodyComponent::saveState() const {
+    State state{};
+    state.x = x_;
+    state.y = y_;
+    state.rotation = rotation_;
+    state.velocityX = velocityX_;
+    state.velocityY = velocityY_;
+    
+    if (B2_IS_NON_NULL(physicsBodyId_)) {
+        // Dynamic bodies keep their velocity in Box2D only (move events carry transforms)
+        b2Vec2 velocity = b2Body_GetLinearVelocity(physicsBodyId_);
+        state.velocityX = velocity.x;
+        state.velocityY = velocity.y;
+        state.angularVelocity = b2Body_GetAngularVelocity(physicsBodyId_);
+        state.bodyIndex = physicsBodyId_.index1;
+        state.bodyGeneration = physicsBodyId_.generation;
+        if (b2Body_IsEnabled(physicsBodyId_)) state.flags |= STATE_ENABLED;
+        if (b2Body_IsAwake(physicsBodyId_)) state.flags |= STATE_AWAKE;
+    }
+    return state;
+}
+
+bool BodyComponent::matchesState(const State& state) const {
+    if (B2_IS_NULL(physicsBodyId_)) return state.bodyIndex == 0;
+    return state.bodyIndex == physicsBodyId_.index1 &&
+           state.bodyGeneration == physicsBodyId_.generation;
+}
+
+// BOX2D INTEGRATION: Put the body back in place (caller checks matchesState first)
+void BodyComponent::restoreState(const State& state) {
+    x_ = state.x;
+    y_ = state.y;
+    rotation_ = state.rotation;
+    velocityX_ = state.velocityX;
+    velocityY_ = state.velocityY;
+    resetInterpolation();  // Don't blend from the pre-restore position
+    
+    if (B2_IS_NULL(physicsBodyId_)) return;
+    
+    bool enabled = (state.flags & STATE_ENABLED) != 0;
+    setPhysicsEnabled(enabled);
+    b2Body_SetTransform(physicsBodyId_, {x_, y_}, b2MakeRot(rotation_));
+    if (!enabled) return;  // Parked: velocities are set again when it re-enters
+    
+    b2Body_SetLinearVelocity(physicsBodyId_, {velocityX_, velocityY_});
+    b2Body_SetAngularVelocity(physicsBodyId_, state.angularVelocity);
+    b2Body_SetAwake(physicsBodyId_, (state.flags & STATE_AWAKE) != 0);
+}
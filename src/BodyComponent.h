@@ -1,14 +1,22 @@
 #pragma once
 #include "Component.h"
 #include <box2d/box2d.h>
+#include <cstdint>
 
 class PhysicsWorld;
 
 class BodyComponent : public Component {
 public:
     BodyComponent(float x = 0, float y = 0, float w = 0, float h = 0);
+    ~BodyComponent() override;
+
+    // Components live in a packed pool and get moved around; the Box2D body
+    // moves with the component and its userData is re-pointed to the new address
+    BodyComponent(BodyComponent&& other) noexcept;
+    BodyComponent& operator=(BodyComponent&& other) noexcept;
     
-    std::string getType() const override { return "BodyComponent"; }
+    static constexpr ComponentType TYPE = ComponentType::Body;
+    const char* getType() const override { return "BodyComponent"; }
     
     float getX() const { return x_; }
     float getY() const { return y_; }
@@ -27,22 +35,58 @@ public:
     float getRotation() const { return rotation_; }
     void setRotation(float rotation) { rotation_ = rotation; }
     
+    // Fixed-step interpolation: the transform at the start of the current tick
+    // is kept so rendering can blend towards the latest one (alpha in [0, 1])
+    void storePreviousTransform() { prevX_ = x_; prevY_ = y_; prevRotation_ = rotation_; }
+    void resetInterpolation() { storePreviousTransform(); }
+    float getInterpolatedX(float alpha) const { return prevX_ + (x_ - prevX_) * alpha; }
+    float getInterpolatedY(float alpha) const { return prevY_ + (y_ - prevY_) * alpha; }
+    float getInterpolatedRotation(float alpha) const;
+    
     void update(float dt) override;
 
     // Box2D physics integration
     void createPhysicsBody(PhysicsWorld* world, b2BodyType type = b2_dynamicBody, float restitution = 0.5f, float gravityScale = 1.0f, float linearDamping = 0.0f);
+    void createSensorBody(PhysicsWorld* world);  // Kinematic body with a sensor covering the sprite
     void destroyPhysicsBody();
+    void setPhysicsEnabled(bool enabled);  // Disabled bodies leave the simulation but keep their shapes
     void syncFromPhysics();  // Copy physics position to visual position
+    void applyPhysicsTransform(const b2Transform& transform);  // Bulk sync from a Box2D move event
     void syncToPhysics();    // Copy visual position to physics (for kinematic control)
     b2BodyId getPhysicsBodyId() const { return physicsBodyId_; }
     bool hasPhysicsBody() const { return B2_IS_NON_NULL(physicsBodyId_); }
+    bool isKinematic() const { return hasPhysicsBody() && bodyType_ == b2_kinematicBody; }
+
+    // Snapshot support: everything needed to put this body back where it was.
+    // The Box2D body id is recorded so a restore can tell it is the same body.
+    struct State {
+        float x, y, rotation;
+        float velocityX, velocityY;
+        float angularVelocity;
+        int32_t bodyIndex;        // b2BodyId::index1 (0 = no physics body)
+        uint16_t bodyGeneration;  // b2BodyId::generation
+        uint8_t flags;            // STATE_ENABLED | STATE_AWAKE
+    };
+    static constexpr uint8_t STATE_ENABLED = 1 << 0;
+    static constexpr uint8_t STATE_AWAKE = 1 << 1;
+
+    State saveState() const;
+    bool matchesState(const State& state) const;
+    void restoreState(const State& state);  // Writes back in place, no body re-creation
 
 private:
+    // Member-wise copy used by the move operations only: a body is never shared
+    BodyComponent(const BodyComponent&) = default;
+    BodyComponent& operator=(const BodyComponent&) = default;
+
     float x_, y_;
     float width_, height_;
     float velocityX_ = 0;
     float velocityY_ = 0;
     float rotation_ = 0.0f;  // Rotation in radians
+    float prevX_, prevY_;
+    float prevRotation_ = 0.0f;
     b2BodyId physicsBodyId_ = b2_nullBodyId;
+    b2BodyType bodyType_ = b2_staticBody;
     PhysicsWorld* physicsWorld_ = nullptr;
 };
@@ -1,15 +1,39 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 class GameObject;
 
+// Compile-time component type ids. Each concrete component declares
+// `static constexpr ComponentType TYPE`, which indexes the per-object slot
+// table and the registry's pool table.
+enum class ComponentType : uint8_t {
+    Body,
+    Sprite,
+    Controller,
+    BounceBehavior,
+    ProjectileBehavior,
+    Count
+};
+
+constexpr size_t MAX_COMPONENT_TYPES = static_cast<size_t>(ComponentType::Count);
+
+// One bit per component type, for "has component" tests
+using ComponentMask = uint32_t;
+static_assert(MAX_COMPONENT_TYPES <= 32, "ComponentMask is too small");
+
+constexpr ComponentMask componentBit(ComponentType type) {
+    return ComponentMask(1) << static_cast<uint32_t>(type);
+}
+
 class Component {
 public:
     virtual ~Component() = default;
     virtual void init() {}
     virtual void update(float dt) {}
     virtual void render() {}
-    virtual std::string getType() const = 0;
+    virtual const char* getType() const = 0;
     
     void setOwner(GameObject* owner) { owner_ = owner; }
     GameObject* getOwner() const { return owner_; }
@@ -0,0 +1,43 @@
+#include "ComponentRegistry.h"
+
+ComponentRegistry& ComponentRegistry::instance() {
+    static ComponentRegistry inst;
+    return inst;
+}
+
+namespace {
+constexpr std::string_view TYPE_NAMES[MAX_COMPONENT_TYPES] = {
+    "BodyComponent",
+    "SpriteComponent",
+    "ControllerComponent",
+    "BounceBehavior",
+    "ProjectileBehavior"
+};
+}
+
+const char* ComponentRegistry::typeName(ComponentType type) {
+    size_t index = static_cast<size_t>(type);
+    return index < MAX_COMPONENT_TYPES ? TYPE_NAMES[index].data() : "Unknown";
+}
+
+bool ComponentRegistry::findType(std::string_view name, ComponentType& type) {
+    for (size_t i = 0; i < MAX_COMPONENT_TYPES; i++) {
+        if (name == TYPE_NAMES[i]) {
+            type = static_cast<ComponentType>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+Component* ComponentRegistry::get(ComponentType type, ComponentHandle handle) {
+    auto& pool = pools_[static_cast<size_t>(type)];
+    return pool ? pool->get(handle) : nullptr;
+}
+
+void ComponentRegistry::remove(ComponentType type, ComponentHandle handle) {
+    auto& pool = pools_[static_cast<size_t>(type)];
+    if (pool) {
+        pool->remove(handle);
+    }
+}
@@ -0,0 +1,145 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "Component.h"
+
+// Stable reference to a component stored in a ComponentPool.
+// The generation guards against using a handle after its slot was recycled.
+struct ComponentHandle {
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    uint32_t index = INVALID_INDEX;
+    uint32_t generation = 0;
+
+    bool isValid() const { return index != INVALID_INDEX; }
+};
+
+// Type-erased pool interface so a GameObject can reach its components
+// without knowing their concrete types
+class IComponentPool {
+public:
+    virtual ~IComponentPool() = default;
+    virtual Component* get(ComponentHandle handle) = 0;
+    virtual void remove(ComponentHandle handle) = 0;
+};
+
+// Dense, contiguous storage for every component of type T.
+// Components are packed in a std::vector so updating or rendering them all is
+// a linear sweep. Removal swaps the last component into the hole, so raw
+// pointers are only valid until the next add/remove on the same pool; hold a
+// ComponentHandle to refer to a component across frames.
+template<typename T>
+class ComponentPool : public IComponentPool {
+public:
+    template<typename... Args>
+    ComponentHandle add(Args&&... args) {
+        uint32_t slotIndex;
+        if (!freeSlots_.empty()) {
+            slotIndex = freeSlots_.back();
+            freeSlots_.pop_back();
+        } else {
+            slotIndex = static_cast<uint32_t>(slots_.size());
+            slots_.push_back({});
+        }
+
+        slots_[slotIndex].dense = static_cast<uint32_t>(components_.size());
+        components_.emplace_back(std::forward<Args>(args)...);
+        denseToSlot_.push_back(slotIndex);
+
+        return {slotIndex, slots_[slotIndex].generation};
+    }
+
+    T* get(ComponentHandle handle) override {
+        if (!contains(handle)) return nullptr;
+        return &components_[slots_[handle.index].dense];
+    }
+
+    void remove(ComponentHandle handle) override {
+        if (!contains(handle)) return;
+
+        uint32_t dense = slots_[handle.index].dense;
+        uint32_t last = static_cast<uint32_t>(components_.size()) - 1;
+
+        // Keep storage packed: move the last component into the freed spot
+        if (dense != last) {
+            components_[dense] = std::move(components_[last]);
+            denseToSlot_[dense] = denseToSlot_[last];
+            slots_[denseToSlot_[dense]].dense = dense;
+        }
+        components_.pop_back();
+        denseToSlot_.pop_back();
+
+        slots_[handle.index].generation++;
+        freeSlots_.push_back(handle.index);
+    }
+
+    bool contains(ComponentHandle handle) const {
+        // Removal bumps the slot generation, so a matching generation means live
+        return handle.index < slots_.size() &&
+               slots_[handle.index].generation == handle.generation;
+    }
+
+    void reserve(size_t capacity) {
+        components_.reserve(capacity);
+        denseToSlot_.reserve(capacity);
+        slots_.reserve(capacity);
+    }
+
+    size_t size() const { return components_.size(); }
+
+    // Iteration over the packed components (do not add/remove while iterating)
+    typename std::vector<T>::iterator begin() { return components_.begin(); }
+    typename std::vector<T>::iterator end() { return components_.end(); }
+
+private:
+    struct Slot {
+        uint32_t dense = 0;
+        uint32_t generation = 0;
+    };
+
+    std::vector<T> components_;          // Packed component storage
+    std::vector<uint32_t> denseToSlot_;  // Packed index -> handle slot
+    std::vector<Slot> slots_;            // Handle slot -> packed index
+    std::vector<uint32_t> freeSlots_;
+};
+
+// Owns one ComponentPool per component type
+class ComponentRegistry {
+public:
+    static ComponentRegistry& instance();
+
+    // Pool index of component type T, fixed at compile time
+    template<typename T>
+    static constexpr size_t typeIndex() {
+        return static_cast<size_t>(T::TYPE);
+    }
+
+    template<typename T>
+    ComponentPool<T>& pool() {
+        auto& slot = pools_[typeIndex<T>()];
+        if (!slot) {
+            slot = std::make_unique<ComponentPool<T>>();
+        }
+        return static_cast<ComponentPool<T>&>(*slot);
+    }
+
+    // Update every component of type T whose owner is active
+    template<typename T>
+    void updateAll(float dt);
+
+    // Name <-> type id mapping for data-driven lookups (matches getType())
+    static const char* typeName(ComponentType type);
+    static bool findType(std::string_view name, ComponentType& type);
+
+    Component* get(ComponentType type, ComponentHandle handle);
+    void remove(ComponentType type, ComponentHandle handle);
+
+private:
+    ComponentRegistry() = default;
+
+    std::array<std::unique_ptr<IComponentPool>, MAX_COMPONENT_TYPES> pools_;
+};
@@ -5,7 +5,8 @@ class ControllerComponent : public Component {
 public:
     ControllerComponent(float speed, int screenWidth);
     
-    std::string getType() const override { return "ControllerComponent"; }
+    static constexpr ComponentType TYPE = ComponentType::Controller;
+    const char* getType() const override { return "ControllerComponent"; }
     
     void update(float dt) override;
     
@@ -0,0 +1,159 @@
+#include "FramePacer.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+const char* FramePacer::modeName(Mode mode) {
+    switch (mode) {
+        case Mode::Auto:     return "auto";
+        case Mode::VSync:    return "vsync";
+        case Mode::Sleep:    return "sleep";
+        case Mode::Uncapped: return "uncapped";
+    }
+    return "unknown";
+}
+
+bool FramePacer::parseMode(const std::string& name, Mode& mode) {
+    for (Mode candidate : {Mode::Auto, Mode::VSync, Mode::Sleep, Mode::Uncapped}) {
+        if (name == modeName(candidate)) {
+            mode = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+void FramePacer::configure(Mode mode, float targetFps, int displayHz) {
+    displayHz_ = displayHz;
+    autoMode_ = mode == Mode::Auto;
+    if (autoMode_) {
+        // VSync gives the smoothest result, but only paces to the display rate
+        bool matchesDisplay = targetFps <= 0.0f || displayHz <= 0 ||
+                              std::abs(targetFps - static_cast<float>(displayHz)) < 1.0f;
+        mode = matchesDisplay ? Mode::VSync : Mode::Sleep;
+    }
+    mode_ = mode;
+
+    // Sleep mode needs a concrete rate; fall back to the display, then 60 Hz
+    targetFps_ = targetFps;
+    if (targetFps_ <= 0.0f) {
+        targetFps_ = displayHz > 0 ? static_cast<float>(displayHz) : 60.0f;
+    }
+    period_ = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / targetFps_));
+
+    history_.assign(HISTORY, 0.0f);
+    historyNext_ = 0;
+    frames_ = 0;
+    sumMs_ = 0.0;
+    sumSquaresMs_ = 0.0;
+    maxMs_ = 0.0;
+    lateFrames_ = 0;
+    started_ = false;
+    modeChanged_ = false;
+}
+
+bool FramePacer::consumeModeChange() {
+    bool changed = modeChanged_;
+    modeChanged_ = false;
+    return changed;
+}
+
+void FramePacer::endFrame() {
+    Clock::time_point now = Clock::now();
+    if (!started_) {
+        started_ = true;
+        nextSlot_ = now;
+    } else {
+        record(std::chrono::duration<double, std::milli>(now - lastFrame_).count());
+    }
+    lastFrame_ = now;
+
+    // Auto: if vsync'd presents come back much faster than the display
+    // refresh, vsync is not actually blocking; pace ourselves instead
+    if (autoMode_ && mode_ == Mode::VSync && frames_ == CALIBRATION_FRAMES) {
+        std::vector<float> recent(history_.begin(), history_.begin() + CALIBRATION_FRAMES);
+        std::nth_element(recent.begin(), recent.begin() + CALIBRATION_FRAMES / 2, recent.end());
+        float medianMs = recent[CALIBRATION_FRAMES / 2];
+        float refreshMs = 1000.0f / (displayHz_ > 0 ? displayHz_ : targetFps_);
+        if (medianMs < 0.75f * refreshMs) {
+            mode_ = Mode::Sleep;
+            modeChanged_ = true;
+            nextSlot_ = now;
+        }
+    }
+
+    if (mode_ == Mode::Sleep) {
+        waitForSlot();
+    }
+}
+
+void FramePacer::waitForSlot() {
+    nextSlot_ += period_;
+    Clock::time_point now = Clock::now();
+
+    // More than a frame behind (hitch, window drag): restart the cadence
+    // from now instead of rushing several frames out back to back
+    if (now > nextSlot_ + period_) {
+        nextSlot_ = now;
+        return;
+    }
+
+    // Coarse sleep up to the spin margin, then learn from how late we woke.
+    // (SDL_Init raises the Windows timer resolution to 1 ms, so sleeps are
+    // usually accurate to a millisecond or two.)
+    Clock::time_point wakeTarget = nextSlot_ - spinMargin_;
+    if (now < wakeTarget) {
+        std::this_thread::sleep_until(wakeTarget);
+        Clock::duration oversleep = Clock::now() - wakeTarget;
+        Clock::duration wanted = oversleep + std::chrono::microseconds(250);
+        if (wanted > spinMargin_) {
+            spinMargin_ = std::min(wanted, period_);  // Overslept: widen at once
+        } else {
+            spinMargin_ -= (spinMargin_ - wanted) / 64;  // Slowly give it back
+        }
+    }
+
+    // Spin the remainder
+    while (Clock::now() < nextSlot_) {
+        std::this_thread::yield();
+    }
+}
+
+void FramePacer::record(double intervalMs) {
+    history_[historyNext_] = static_cast<float>(intervalMs);
+    historyNext_ = (historyNext_ + 1) % HISTORY;
+    frames_++;
+    sumMs_ += intervalMs;
+    sumSquaresMs_ += intervalMs * intervalMs;
+    maxMs_ = std::max(maxMs_, intervalMs);
+
+    double expectedMs = 0.0;
+    if (mode_ == Mode::Sleep) {
+        expectedMs = 1000.0 / targetFps_;
+    } else if (mode_ == Mode::VSync) {
+        expectedMs = 1000.0 / (displayHz_ > 0 ? displayHz_ : targetFps_);
+    }
+    if (expectedMs > 0.0 && intervalMs > 1.5 * expectedMs) {
+        lateFrames_++;
+    }
+}
+
+FramePacer::Stats FramePacer::computeStats() const {
+    Stats stats;
+    stats.frames = frames_;
+    stats.lateFrames = lateFrames_;
+    stats.maxMs = maxMs_;
+    stats.spinMarginMs = std::chrono::duration<double, std::milli>(spinMargin_).count();
+    if (frames_ == 0) return stats;
+
+    stats.meanMs = sumMs_ / frames_;
+    double variance = sumSquaresMs_ / frames_ - stats.meanMs * stats.meanMs;
+    stats.jitterMs = std::sqrt(std::max(0.0, variance));
+
+    size_t count = static_cast<size_t>(std::min<long long>(frames_, HISTORY));
+    std::vector<float> recent(history_.begin(), history_.begin() + count);
+    std::sort(recent.begin(), recent.end());
+    stats.p50Ms = recent[count / 2];
+    stats.p99Ms = recent[std::min(count - 1, count * 99 / 100)];
+    return stats;
+}
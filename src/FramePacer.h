@@ -0,0 +1,84 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Paces the render loop and measures how evenly frames are presented.
+//
+// Modes:
+//  - VSync:    present() blocks on the display; the pacer only measures.
+//  - Sleep:    vsync off; wait for the next frame slot with a coarse sleep,
+//              then spin the last stretch. The spin margin adapts to how much
+//              the OS has been oversleeping, so slots are hit without burning
+//              a whole core.
+//  - Uncapped: vsync off, no waiting.
+//  - Auto:     VSync when the display refresh rate matches the target rate
+//              (or no target is set), Sleep otherwise. If VSync turns out not to
+//              block (driver override, some remote sessions), it falls back to
+//              Sleep after a short calibration window.
+class FramePacer {
+public:
+    enum class Mode { Auto, VSync, Sleep, Uncapped };
+
+    static const char* modeName(Mode mode);
+    static bool parseMode(const std::string& name, Mode& mode);
+
+    // targetFps <= 0 means "display rate"; displayHz <= 0 if unknown
+    void configure(Mode mode, float targetFps, int displayHz);
+
+    Mode getMode() const { return mode_; }  // Resolved, never Auto
+    bool usesVSync() const { return mode_ == Mode::VSync; }
+    float getTargetFps() const { return targetFps_; }
+
+    // True once after the pacer switched modes on its own (apply usesVSync())
+    bool consumeModeChange();
+
+    // Call right after present(): waits for the next slot (Sleep mode) and
+    // records the interval since the previous call
+    void endFrame();
+
+    struct Stats {
+        long long frames = 0;
+        double meanMs = 0.0;
+        double jitterMs = 0.0;  // Standard deviation of the interval
+        double p50Ms = 0.0;     // Percentiles over the most recent intervals
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+        long long lateFrames = 0;  // Interval over 1.5x the target period
+        double spinMarginMs = 0.0; // Current sleep-to-spin hand-over (Sleep mode)
+    };
+    Stats computeStats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void waitForSlot();
+    void record(double intervalMs);
+
+    static constexpr size_t HISTORY = 4096;         // Intervals kept for percentiles
+    static constexpr int CALIBRATION_FRAMES = 60;   // VSync sanity check (Auto)
+
+    Mode mode_ = Mode::VSync;
+    bool autoMode_ = false;
+    bool modeChanged_ = false;
+    float targetFps_ = 0.0f;
+    int displayHz_ = 0;
+    Clock::duration period_ = Clock::duration::zero();
+
+    Clock::time_point lastFrame_;
+    Clock::time_point nextSlot_;
+    bool started_ = false;
+
+    // Oversleep tracking: spin this long before each slot
+    Clock::duration spinMargin_ = std::chrono::milliseconds(2);
+
+    // Interval statistics
+    std::vector<float> history_;  // Ring buffer, milliseconds
+    size_t historyNext_ = 0;
+    long long frames_ = 0;
+    double sumMs_ = 0.0;
+    double sumSquaresMs_ = 0.0;
+    double maxMs_ = 0.0;
+    long long lateFrames_ = 0;
+};
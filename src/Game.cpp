@@ -11,242 +11,428 @@
 #include "ControllerComponent.h"
 #include "BehaviorComponent.h"
 #include "PhysicsWorld.h"
+#include "ComponentRegistry.h"
+#include "Snapshot.h"
 
 using namespace std::chrono_literals;
 
-int Game::run() {
+int Game::run(const LaunchOptions& options) {
+    options_ = options;
+    // assets.pak (built by tools/asset_packer) replaces the loose files
+    if (archive_.open("assets/assets.pak")) {
+        std::cout << "Using assets/assets.pak (" << archive_.getSize() / 1024 << " KB, "
+                  << archive_.getEntries().size() << " entries)\n";
+    }
     if (!loadConfig("assets/config.xml")) {
         std::cerr << "Using defaults (could not load assets/config.xml)\n";
     }
+    if (!options_.fontPath.empty()) {
+        fontPath_ = options_.fontPath;
+    }
     if (!init()) {
         std::cerr << "Init failed.\n";
         return 1;
     }
 
-    auto lastTime = std::chrono::steady_clock::now();
+    // Simulation runs at a fixed tick rate on its own thread; this thread
+    // only handles events and renders, so neither can stall the other
+    const float tickDt = 1.0f / tickRate_;
+    
+    simulationRunning_ = true;
+    std::thread simulation(&Game::simulationLoop, this);
+    if (assetLoader_) {
+        assetLoader_->start();
+    }
+    
     bool running = true;
-
+    uint64_t lastTick = 0;
     while (running) {
         // Calculate frame start time
         auto frameStart = std::chrono::steady_clock::now();
-        
-        // Calculate deltaTime from last frame
-        auto currentTime = std::chrono::steady_clock::now();
-        float dt = std::chrono::duration<float>(currentTime - lastTime).count();
-        lastTime = currentTime;
-
-        // Cap dt to prevent large jumps (e.g., when debugging or window dragging)
-        if (dt > 0.1f) dt = 0.1f;
 
-        // Process input events
-        input_.update();
+        // Process input events (SDL requires this on the main thread); key
+        // and mouse edges are queued for the simulation as they are pumped.
+        // State is sampled after the pump, so it is not a frame behind.
         if (!input_.processEvents() || input_.quitRequested()) {
             running = false;
         }
+        input_.update();
+        if (options_.maxFrames > 0 && frameStats_.frames + 1 >= options_.maxFrames) {
+            running = false;  // This is the last frame
+        }
 
-        handleInput();
-        update(dt);
-        render();
+        // Finish background loading here: the atlas upload needs the renderer
+        if (assetLoader_ && assetLoader_->poll()) {
+            assetLoader_->printReport();
+            if (!assetLoader_->succeeded()) {
+                std::cerr << "Warning: Some assets failed to load\n";
+            }
+            assetLoader_.reset();
+            if (setupPrototypes()) {
+                assetsReady_ = true;
+            } else {
+                running = false;
+            }
+        }
 
-        // Calculate frame duration
-        auto frameEnd = std::chrono::steady_clock::now();
-        float frameDuration = std::chrono::duration<float, std::milli>(frameEnd - frameStart).count();
+        // Pick up the newest tick, if any
+        if (frames_.acquire()) {
+            uint64_t tick = frames_.readBuffer().tick;
+            if (lastTick != 0 && tick > lastTick + 1) {
+                frameStats_.skippedTicks += static_cast<long long>(tick - lastTick - 1);
+            }
+            lastTick = tick;
+        } else {
+            frameStats_.repeatedFrames++;
+        }
+        const RenderSnapshot& frame = frames_.readBuffer();
         
-        // Delay if work finished early to maintain target FPS
-        if (frameDuration < TARGET_FRAME_TIME) {
-            float delayTime = TARGET_FRAME_TIME - frameDuration;
-            std::this_thread::sleep_for(std::chrono::duration<float, std::milli>(delayTime));
+        // Render between the snapshot's previous and current tick, by how far
+        // we are into the tick that follows it
+        float sinceTick = std::chrono::duration<float>(frameStart - frame.tickTime).count();
+        float alpha = std::clamp(sinceTick / tickDt, 0.0f, 1.0f);
+        render(frame, alpha);
+        frameStats_.frames++;
+
+        // Wait for the next frame slot (unless vsync already did) and measure
+        pacer_.endFrame();
+        if (pacer_.consumeModeChange()) {
+            graphics_.setVSync(pacer_.usesVSync());
+            std::cout << "Frame pacing: vsync is not blocking, switched to "
+                      << FramePacer::modeName(pacer_.getMode()) << "\n";
         }
     }
 
+    simulationRunning_ = false;
+    simulation.join();
     shutdown();
     return 0;
 }
 
+void Game::simulationLoop() {
+    const float tickDt = 1.0f / tickRate_;
+    const auto tickDuration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<float>(tickDt));
+    auto nextTick = std::chrono::steady_clock::now();
+    
+    while (simulationRunning_) {
+        keys_ = input_.takeKeys();
+        tick(tickDt);
+        publishSnapshot();
+        
+        // Late ticks run back to back to catch up, but after a long stall
+        // (debugger, window drag) drop the missed time rather than spiralling
+        nextTick += tickDuration;
+        auto now = std::chrono::steady_clock::now();
+        if (now - nextTick > tickDuration * MAX_CATCH_UP_TICKS) {
+            nextTick = now;
+        }
+        std::this_thread::sleep_until(nextTick);
+    }
+}
+
 bool Game::loadConfig(const std::string& path) {
-    tinyxml2::XMLDocument doc;
-    if (doc.LoadFile(path.c_str()) != tinyxml2::XML_SUCCESS) {
-        std::cerr << "Failed to load XML: " << path << "\n";
+    GameConfig config;
+    bool ok;
+    if (const AssetArchive::Entry* packed = archive_.find("config.xml")) {
+        SnapshotReader reader(packed->data, packed->size);
+        ok = config.read(reader);
+        if (!ok) {
+            std::cerr << "Failed to read packed config\n";
+            config = GameConfig();
+        }
+    } else {
+        ok = config.loadXML(path);
+    }
+    applyConfig(config);
+    if (ok) {
+        std::cout << "Loaded config: title=\"" << title_ << "\"\n";
+    }
+    return ok;
+}
+
+void Game::applyConfig(const GameConfig& config) {
+    title_ = config.title;
+    squirrelSpeed_ = config.squirrelSpeed;
+    acornSpeed_ = config.acornSpeed;
+    leafSpeedX_ = config.leafSpeedX;
+    leafSpeedY_ = config.leafSpeedY;
+    acornPoolSize_ = config.acornPoolSize;
+    acornCooldownTime_ = config.acornCooldown;
+    physicsWorkers_ = config.physicsWorkers;
+    tickRate_ = config.tickRate > 0.0f ? config.tickRate : 60.0f;
+    maxFps_ = config.maxFps;
+    fontPath_ = config.font;
+    if (!FramePacer::parseMode(config.frameMode, frameMode_)) {
+        std::cerr << "Unknown frameMode \"" << config.frameMode << "\" (auto, vsync, sleep, uncapped)\n";
+    }
+}
+
+// Everything the background loader would produce, straight from the mapped
+// archive: atlas pages are uploaded from their pixels, objects are read from
+// their binary record
+bool Game::loadPackedAssets() {
+    auto start = std::chrono::steady_clock::now();
+    const AssetArchive::Entry* objects = archive_.find("objects.xml");
+    if (!objects || !graphics_.loadAtlas(archive_)) {
+        return false;
+    }
+    SnapshotReader reader(objects->data, objects->size);
+    if (!ObjectFactory::instance().loadFromBinary(reader)) {
+        graphics_.clearTextures();  // The loose files are loaded from scratch instead
         return false;
     }
-    auto* root = doc.RootElement();
-    if (!root) return false;
-    if (const char* t = root->Attribute("title")) title_ = t;
-    root->QueryFloatAttribute("squirrelSpeed", &squirrelSpeed_);
-    root->QueryFloatAttribute("acornSpeed", &acornSpeed_);
-    root->QueryFloatAttribute("leafSpeedX", &leafSpeedX_);
-    root->QueryFloatAttribute("leafSpeedY", &leafSpeedY_);
-    std::cout << "Loaded config: title=\"" << title_ << "\"\n";
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Assets loaded from assets.pak in " << ms << " ms\n";
     return true;
 }
 
+// The configured font (or --font) if given, else the first platform font found
+bool Game::loadFont() {
+    if (!fontPath_.empty()) {
+        return graphics_.loadFont(fontPath_, FONT_SIZE);
+    }
+    std::string path = Graphics::findSystemFont();
+    if (path.empty()) {
+        std::cerr << "No font found; set font=\"...\" in assets/config.xml or pass --font\n";
+        return false;
+    }
+    return graphics_.loadFont(path, FONT_SIZE);
+}
+
 bool Game::init() {
     // Initialize graphics system
-    if (!graphics_.init(title_, SCREEN_WIDTH, SCREEN_HEIGHT)) {
+    if (!graphics_.init(title_, SCREEN_WIDTH, SCREEN_HEIGHT, options_.headless)) {
         return false;
     }
 
     // Load font
-    if (!graphics_.loadFont("C:\\Windows\\Fonts\\arial.ttf", 24)) {
+    if (!loadFont()) {
         std::cerr << "Warning: Failed to load font\n";
     }
 
-    // Load textures
-    graphics_.loadTexture("SQRL", "assets/SQRL.png");
-    graphics_.loadTexture("acorn", "assets/acorn.png");
-    graphics_.loadTexture("leaf", "assets/leaf.png");
-    graphics_.loadTexture("RBIRD", "assets/RBIRD.png");
+    // Textures and object templates: from assets.pak if there is one,
+    // otherwise loaded in the background from the loose files, where every
+    // PNG is decoded on a worker, reduced to the display size listed in the
+    // manifest and packed into the atlas. The title screen shows progress
+    // meanwhile (see run()).
+    if (archive_.isOpen() && loadPackedAssets()) {
+        if (!setupPrototypes()) return false;
+        assetsReady_ = true;
+    } else {
+        if (archive_.isOpen()) {
+            std::cerr << "Warning: assets.pak could not be used, loading the loose files\n";
+        }
+        assetLoader_ = std::make_unique<AssetLoader>(graphics_);
+        assetLoader_->addTextureManifest("assets/textures.xml");
+        assetLoader_->addTextureFolder("assets");
+        assetLoader_->addTask("assets/objects.xml", [] {
+            return ObjectFactory::instance().loadFromXML("assets/objects.xml");
+        });
+    }
+    archive_.close();  // Everything in it has been uploaded or copied
+
+    // Cached layers for the parts of the screen that rarely change
+    backgroundLayer_ = graphics_.createLayer();
+    titleLayer_ = graphics_.createLayer();
+    hudLayer_ = graphics_.createLayer();
 
     // Initialize view centered on screen
     view_.setCenter(SCREEN_WIDTH / 2.0f, SCREEN_HEIGHT / 2.0f);
     view_.setSize(SCREEN_WIDTH, SCREEN_HEIGHT);
     
+    // Frame pacing: the renderer starts with vsync on; keep it only if the
+    // pacer decides to rely on it. Headless frames are never throttled.
+    pacer_.configure(options_.headless ? FramePacer::Mode::Uncapped : frameMode_, maxFps_,
+                     graphics_.getDisplayRefreshRate());
+    graphics_.setVSync(pacer_.usesVSync());
+    std::cout << "Frame pacing: " << FramePacer::modeName(pacer_.getMode()) << " at "
+              << pacer_.getTargetFps() << " fps (display " << graphics_.getDisplayRefreshRate() << " Hz)\n";
+
     // Register view as static instance in Graphics for engine-level access
     Graphics::setView(&view_);
 
+    // BOX2D INTEGRATION: Spread the physics step across worker threads
+    // (the world is rebuilt with the task hooks, so do this before any body exists)
+    if (physicsWorkers_ != 1) {
+        taskSystem_ = std::make_unique<TaskSystem>(physicsWorkers_);
+        physicsWorld_.setTaskSystem(taskSystem_.get());
+    }
+    std::cout << "Physics workers: " << physicsWorld_.getWorkerCount() << "\n";
+
     // BOX2D INTEGRATION: Initialize physics world with downward gravity
     // Gravity of 400 units makes acorns fall realistically
     // Use positive Y gravity (screen coordinates: Y increases downward)
     physicsWorld_.setGravity(0.0f, 400.0f);
     
     // BOX2D INTEGRATION: Register collision callback for contact listening
-    // This lambda will be called whenever two physics bodies collide
-    physicsWorld_.setContactCallback([this](void* bodyA, void* bodyB) {
-        this->handleCollision(bodyA, bodyB);
+    // This lambda receives every contact Box2D reported for a step, in one batch
+    physicsWorld_.setContactCallback([this](const std::vector<ContactEvent>& events) {
+        this->handleContacts(events);
     });
 
-    // Register object types (don't create game objects until title screen is dismissed)
-    registerObjectTypes();
+    // Object prototypes are set up once objects.xml and the atlas are loaded
+    // (don't create game objects until title screen is dismissed)
     
     std::cout << "Init complete. Squirrel Acorn Game ready!\n";
     return true;
 }
 
 void Game::shutdown() {
+    std::cout << "Acorn pool: capacity " << acornPool_.capacity()
+              << ", high-water mark " << acornPool_.highWaterMark()
+              << ", exhausted " << acornPool_.exhaustedCount() << " times\n";
+    if (physicsSteps_ > 0) {
+        std::cout << "Physics sync: " << static_cast<double>(physicsSyncedBodies_) / physicsSteps_
+                  << " bodies/step on average, " << maxSyncedBodies_ << " max, over "
+                  << physicsSteps_ << " steps\n";
+    }
+    const Graphics::TextStats& text = graphics_.getTextStats();
+    std::cout << "Text: " << text.textureUploads << " glyph texture uploads in " << text.framesWithUploads
+              << " of " << text.frames << " frames (last frame: " << text.frameUploads << " uploads, "
+              << text.frameDrawCalls << " draw calls, " << text.frameGlyphs << " glyphs)\n";
+    FramePacer::Stats pacing = pacer_.computeStats();
+    std::cout << "Frame pacing (" << FramePacer::modeName(pacer_.getMode()) << "): " << pacing.frames
+              << " intervals, mean " << pacing.meanMs << " ms, jitter " << pacing.jitterMs << " ms, p50 "
+              << pacing.p50Ms << " ms, p99 " << pacing.p99Ms << " ms, max " << pacing.maxMs << " ms, "
+              << pacing.lateFrames << " late\n";
+    std::cout << "Frames: " << frameStats_.frames << " rendered for " << ticks_ << " ticks, "
+              << frameStats_.repeatedFrames << " without a new tick, "
+              << frameStats_.skippedTicks << " ticks never shown\n";
+    Input::LatencyStats input = input_.getLatencyStats();
+    std::cout << "Input: " << input.events << " events, latency to simulation mean " << input.meanMs()
+              << " ms, max " << input.maxMs << " ms, " << input.dropped << " dropped\n";
+    std::cout << "Culling: " << cullStats_.totalDrawn << " sprites drawn, " << cullStats_.totalCulled
+              << " culled (last frame " << cullStats_.drawn << " drawn, " << cullStats_.culled << " culled)\n";
+    const Graphics::SpriteStats& sprites = graphics_.getSpriteStats();
+    const Graphics::LayerStats& layers = graphics_.getLayerStats();
+    std::cout << "Layers: " << layers.redraws << " redraws in " << layers.framesWithRedraws
+              << " of " << layers.frames << " frames\n";
+    const Graphics::PrimitiveStats& shapes = graphics_.getPrimitiveStats();
+    std::cout << "Primitives: " << shapes.frameShapes << " in " << shapes.frameDrawCalls
+              << " draw calls last frame, " << shapes.maxShapes << " max per frame\n";
+    std::cout << "Sprites: " << sprites.frameSprites << " in " << sprites.frameDrawCalls
+              << " draw calls last frame, " << sprites.maxDrawCalls << " max\n";
     graphics_.shutdown();
 }
 
-void Game::registerObjectTypes() {
+// Prototypes from objects.xml, finished once the atlas exists: sprite
+// regions are resolved and config.xml speeds applied, so every later create()
+// is a plain copy
+bool Game::setupPrototypes() {
     auto& factory = ObjectFactory::instance();
+    factory.setWorld(&physicsWorld_, graphics_.getRenderer(), SCREEN_WIDTH, SCREEN_HEIGHT);
+    factory.resolveTextures(graphics_);
+    
+    squirrelType_ = factory.findPrototype("Squirrel");
+    leafType_ = factory.findPrototype("Leaf");
+    acornType_ = factory.findPrototype("Acorn");
+    redBlockType_ = factory.findPrototype("RedBlock");
+    ObjectPrototype* squirrel = factory.getPrototype(squirrelType_);
+    ObjectPrototype* leaf = factory.getPrototype(leafType_);
+    ObjectPrototype* acorn = factory.getPrototype(acornType_);
+    if (!squirrel || !leaf || !acorn || !factory.getPrototype(redBlockType_)) {
+        std::cerr << "assets/objects.xml must define Squirrel, Leaf, Acorn and RedBlock\n";
+        return false;
+    }
     
-    // Register Squirrel
-    factory.registerType("Squirrel", [this](const ObjectParams& params) {
-        auto obj = std::make_unique<GameObject>("Squirrel");
-        obj->addComponent(std::make_unique<BodyComponent>(params.x, params.y, params.width, params.height));
-        auto sprite = std::make_unique<SpriteComponent>("SQRL", graphics_.getRenderer());
-        sprite->setTexture(graphics_.getTexture("SQRL"));
-        obj->addComponent(std::move(sprite));
-        obj->addComponent(std::make_unique<ControllerComponent>(params.speed, SCREEN_WIDTH));
-        return obj;
-    });
-    
-    // Register Leaf
-    factory.registerType("Leaf", [this](const ObjectParams& params) {
-        auto obj = std::make_unique<GameObject>("Leaf");
-        auto body = std::make_unique<BodyComponent>(params.x, params.y, params.width, params.height);
-        body->setVelocity(params.velocityX, params.velocityY);
-        obj->addComponent(std::move(body));
-        auto sprite = std::make_unique<SpriteComponent>("leaf", graphics_.getRenderer());
-        sprite->setTexture(graphics_.getTexture("leaf"));
-        obj->addComponent(std::move(sprite));
-        obj->addComponent(std::make_unique<BounceBehavior>(SCREEN_WIDTH, SCREEN_HEIGHT));
-        return obj;
-    });
-    
-    // Register Acorn
-    factory.registerType("Acorn", [this](const ObjectParams& params) {
-        auto obj = std::make_unique<GameObject>("Acorn");
-        auto body = std::make_unique<BodyComponent>(params.x, params.y, params.width, params.height);
-        body->setVelocity(0, params.speed);
-        obj->addComponent(std::move(body));
-        auto sprite = std::make_unique<SpriteComponent>("acorn", graphics_.getRenderer());
-        sprite->setTexture(graphics_.getTexture("acorn"));
-        obj->addComponent(std::move(sprite));
-        obj->addComponent(std::make_unique<ProjectileBehavior>(SCREEN_HEIGHT));
-        return obj;
-    });
-    
-    // Register RedBlock (fast moving obstacle - red bird)
-    factory.registerType("RedBlock", [this](const ObjectParams& params) {
-        auto obj = std::make_unique<GameObject>("RedBlock");
-        auto body = std::make_unique<BodyComponent>(params.x, params.y, params.width, params.height);
-        body->setVelocity(params.velocityX, params.velocityY);
-        obj->addComponent(std::move(body));
-        auto sprite = std::make_unique<SpriteComponent>("RBIRD", graphics_.getRenderer());
-        sprite->setTexture(graphics_.getTexture("RBIRD"));
-        obj->addComponent(std::move(sprite));
-        obj->addComponent(std::make_unique<BounceBehavior>(SCREEN_WIDTH, SCREEN_HEIGHT));
-        return obj;
-    });
-    
-    factory.loadFromXML("assets/objects.xml");
+    squirrel->speed = squirrelSpeed_;
+    leaf->body.velocityX = leafSpeedX_ * 0.5f;  // 50% of config speed
+    leaf->body.velocityY = leafSpeedY_ * 0.5f;
+    acorn->body.velocityY = acornSpeed_;
+    acornWidth_ = acorn->body.width;
+    acornHeight_ = acorn->body.height;
+    acornIcon_ = acorn->sprite.texture;
+    std::cout << "Object prototypes ready: " << factory.getPrototypeCount() << "\n";
+    return true;
 }
 
 void Game::createGameObjects() {
     auto& factory = ObjectFactory::instance();
     
-    // Create squirrel
-    ObjectParams squirrelParams;
-    squirrelParams.x = 400.0f;
-    squirrelParams.y = 50.0f;
-    squirrelParams.width = 80.0f;
-    squirrelParams.height = 80.0f;
-    squirrelParams.speed = squirrelSpeed_;
-    squirrel_ = factory.create("Squirrel", squirrelParams);
+    // Create squirrel (its kinematic physics body is player controlled)
+    squirrel_ = factory.create(squirrelType_);
     squirrel_->init();
     
-    // Create physics body for squirrel (kinematic - player controlled)
-    auto* squirrelBody = squirrel_->getComponent<BodyComponent>();
-    if (squirrelBody) {
-        squirrelBody->createPhysicsBody(&physicsWorld_, b2_kinematicBody);
-    }
-    
     // Create leaf
-    ObjectParams leafParams;
-    leafParams.x = 400.0f;
-    leafParams.y = 500.0f;
-    leafParams.width = 90.0f;
-    leafParams.height = 90.0f;
-    leafParams.velocityX = leafSpeedX_ * 0.5f;  // 50% of config speed
-    leafParams.velocityY = leafSpeedY_ * 0.5f;
-    leaf_ = factory.create("Leaf", leafParams);
+    leaf_ = factory.create(leafType_);
     leaf_->init();
     
-    // Leaf uses simple velocity movement (no physics body)
+    // Leaf moves by its own velocity; its kinematic sensor body just follows
+    
+    // Red bird joins in level 2; create it now, parked, so every level uses the
+    // same set of bodies and a level restart can restore them in place
+    redBlock_ = factory.create(redBlockType_);
+    redBlock_->init();
+    redBlock_->setActive(false);
+    redBlock_->getComponent<BodyComponent>()->setPhysicsEnabled(false);
+    
+    // Pre-create the acorns (and their physics bodies) once; shots reuse them
+    if (acornPool_.capacity() == 0) {
+        createAcornPool();
+    }
+    
+    captureLevelStart();
+}
+
+void Game::createAcornPool() {
+    // Snapshots store pool indices as 16 bits
+    size_t count = static_cast<size_t>(std::clamp(acornPoolSize_, 1, static_cast<int>(UINT16_MAX)));
+    ObjectFactory::instance().reserve(acornType_, count);
+    
+    // BOX2D INTEGRATION: each acorn gets a dynamic physics body from its
+    // prototype (low restitution for a realistic bounce); the pool disables
+    // it until fired
+    acornPool_.init(count, [this]() {
+        auto acorn = ObjectFactory::instance().create(acornType_);
+        if (acorn) acorn->init();
+        return acorn;
+    });
+    
+    std::cout << "Acorn pool ready: " << acornPool_.capacity() << " acorns\n";
 }
 
 GameObject* Game::spawnAcorn(float x, float y) {
-    ObjectParams acornParams;
-    acornParams.x = x;
-    acornParams.y = y;
-    acornParams.width = acornWidth_;
-    acornParams.height = acornHeight_;
-    acornParams.speed = acornSpeed_;
-    
-    auto acorn = ObjectFactory::instance().create("Acorn", acornParams);
-    acorn->init();
-    
-    // BOX2D INTEGRATION: Create dynamic physics body for acorn
-    // Dynamic bodies are affected by gravity and forces
+    GameObject* acorn = acornPool_.acquire();
+    if (!acorn) return nullptr;  // Every pooled acorn is in flight
+    
     auto* acornBody = acorn->getComponent<BodyComponent>();
     if (acornBody) {
-        // Create body with low restitution (0.15) for realistic bounce
-        acornBody->createPhysicsBody(&physicsWorld_, b2_dynamicBody, 0.15f);
-        acornBody->syncToPhysics(); // Apply initial upward velocity to physics
+        acornBody->setPosition(x, y);
+        acornBody->setVelocity(0, acornSpeed_);
+        acornBody->setRotation(0.0f);
+        acornBody->resetInterpolation(); // Fresh shot: don't interpolate from where it was parked
         
-        // BOX2D REQUIREMENT: Angular velocity demonstration - make acorns spin
-        // Sets rotation speed to 3.0 radians per second (clockwise)
-        b2Body_SetAngularVelocity(acornBody->getPhysicsBodyId(), 3.0f);
+        if (acornBody->hasPhysicsBody()) {
+            b2BodyId bodyId = acornBody->getPhysicsBodyId();
+            b2Body_SetTransform(bodyId, {x, y}, b2Rot_identity);
+            acornBody->syncToPhysics(); // Apply initial downward velocity to physics
+            
+            // BOX2D REQUIREMENT: Angular velocity demonstration - make acorns spin
+            // Sets rotation speed to 3.0 radians per second (clockwise)
+            b2Body_SetAngularVelocity(bodyId, 3.0f);
+        }
     }
     
-    acorns_.push_back(std::move(acorn));
-    return acorns_.back().get();
+    return acorn;
 }
 
-void Game::handleInput() {
+void Game::tick(float dt) {
+    // Remember where every body was so rendering can interpolate to the new state
+    for (auto& body : ComponentRegistry::instance().pool<BodyComponent>()) {
+        body.storePreviousTransform();
+    }
+    
+    handleInput(dt);
+    update(dt);
+}
+
+void Game::handleInput(float dt) {
     // Title screen: press SPACE or ENTER to start
     if (gameState_ == GameState::TITLE_SCREEN) {
-        if (input_.isKeyPressed(Key::SPACE) || input_.isKeyPressed(Key::ENTER)) {
+        // Objects need their textures and templates, so wait for loading
+        if (!assetsReady_) return;
+        if (keys_.isPressed(Key::SPACE) || keys_.isPressed(Key::ENTER)) {
             gameState_ = GameState::PLAYING;
             createGameObjects();
         }
@@ -256,33 +442,39 @@ void Game::handleInput() {
     // Only handle game input when playing
     if (gameState_ != GameState::PLAYING) return;
     
-    float dt = 1.0f / 60.0f;
+    // Restart the current level (also works after game over)
+    if (keys_.isPressed(Key::R)) {
+        restartLevel();
+        return;
+    }
     
     auto* controller = squirrel_->getComponent<ControllerComponent>();
     if (controller) {
         // Move squirrel left/right
-        if (input_.isKeyDown(Key::LEFT) || input_.isKeyDown(Key::A)) {
+        // Held, or tapped within the tick
+        if (keys_.isHeld(Key::LEFT) || keys_.isHeld(Key::A)) {
             controller->moveLeft(dt);
         }
-        if (input_.isKeyDown(Key::RIGHT) || input_.isKeyDown(Key::D)) {
+        if (keys_.isHeld(Key::RIGHT) || keys_.isHeld(Key::D)) {
             controller->moveRight(dt);
         }
     }
 
     // Shoot acorn with W key or Up arrow
-    if (!gameOver_ && !gameWon_ && (input_.isKeyDown(Key::W) || input_.isKeyDown(Key::UP))) {
+    if (!gameOver_ && !gameWon_ && (keys_.isHeld(Key::W) || keys_.isHeld(Key::UP))) {
         if (acornCooldown_ <= 0.0f && nutsRemaining_ > 0) {
             auto* squirrelBody = squirrel_->getComponent<BodyComponent>();
             if (squirrelBody) {
                 float acornX = squirrelBody->getX() + squirrelBody->getWidth() / 2 - acornWidth_ / 2;
                 float acornY = squirrelBody->getY() + squirrelBody->getHeight();
-                spawnAcorn(acornX, acornY);
-                acornCooldown_ = ACORN_COOLDOWN_TIME;
-                nutsRemaining_--;
-                
-                if (nutsRemaining_ <= 0) {
-                    gameOver_ = true;
-                    std::cout << "Game Over! You ran out of nuts!\n";
+                if (spawnAcorn(acornX, acornY)) {
+                    acornCooldown_ = acornCooldownTime_;
+                    nutsRemaining_--;
+                    
+                    if (nutsRemaining_ <= 0) {
+                        gameOver_ = true;
+                        std::cout << "Game Over! You ran out of nuts!\n";
+                    }
                 }
             }
         }
@@ -295,143 +487,37 @@ void Game::update(float dt) {
     
     // BOX2D-SDL INTEGRATION: Step physics simulation forward in time
     // This advances all physics bodies by one frame (applies gravity, resolves collisions, etc.)
-    // Must be called BEFORE updating game objects so they can sync from physics
+    // Must be called BEFORE updating game objects: the step also copies every body
+    // that moved into its BodyComponent (from Box2D move events)
     physicsWorld_.step(dt);
+    physicsSteps_++;
+    physicsSyncedBodies_ += physicsWorld_.getLastSyncCount();
+    maxSyncedBodies_ = std::max(maxSyncedBodies_, physicsWorld_.getLastSyncCount());
     
     // Update cooldown timer
     if (acornCooldown_ > 0.0f) {
         acornCooldown_ -= dt;
     }
 
-    // Update game objects (they will sync their visual positions from physics)
-    squirrel_->update(dt);
-    leaf_->update(dt);
-
-    auto* leafBody = leaf_->getComponent<BodyComponent>();
-    
-    // Update acorns
-    for (auto& acorn : acorns_) {
-        if (!acorn->isActive()) continue;
-        
-        acorn->update(dt);
-        
-        auto* acornBody = acorn->getComponent<BodyComponent>();
+    // Update game objects one component type at a time. Each pool is packed,
+    // so these are linear sweeps (bodies first so they sync from physics)
+    auto& registry = ComponentRegistry::instance();
+    registry.updateAll<BodyComponent>(dt);
+    registry.updateAll<ControllerComponent>(dt);
+    registry.updateAll<BounceBehavior>(dt);
+    registry.updateAll<ProjectileBehavior>(dt);
+
+    // Hits on the leaf and red bird arrive as sensor events from the physics
+    // step (see handleContacts), so only off-screen acorns are retired here
+    for (GameObject* acorn : acornPool_.active()) {
         auto* projectile = acorn->getComponent<ProjectileBehavior>();
-        
-        // Check collision with leaf
-        if (acornBody && leafBody) {
-            float ax = acornBody->getX();
-            float ay = acornBody->getY();
-            float aw = acornBody->getWidth();
-            float ah = acornBody->getHeight();
-            float lx = leafBody->getX();
-            float ly = leafBody->getY();
-            float lw = leafBody->getWidth();
-            float lh = leafBody->getHeight();
-            
-            // BOX2D REQUIREMENT: AABB Query for collision detection
-            // Manual Axis-Aligned Bounding Box check (leaf has no physics body)
-            if (ax < lx + lw &&
-                ax + aw > lx &&
-                ay < ly + lh &&
-                ay + ah > ly) {
-                
-                std::cout << "COLLISION DETECTED! Acorn(" << ax << "," << ay << ") Leaf(" << lx << "," << ly << ")\n";
-                
-                // BOX2D REQUIREMENT: Linear velocity manipulation for bounce effect
-                // Apply bounce by reversing and dampening velocity (simulates elastic collision)
-                if (acornBody->hasPhysicsBody()) {
-                    b2Vec2 currentVel = b2Body_GetLinearVelocity(acornBody->getPhysicsBodyId());
-                    // Reverse vertical velocity and dampen (60% of original speed, 80% horizontal)
-                    b2Body_SetLinearVelocity(acornBody->getPhysicsBodyId(), {currentVel.x * 0.8f, -currentVel.y * 0.6f});
-                }
-                
-                hits_++;
-                score_++;
-                std::cout << "Hit! Points: " << hits_ << "/" << hitsToWin_ << "\n";
-                
-                if (hits_ >= hitsToWin_) {
-                    if (currentLevel_ == 1) {
-                        levelTransition_ = true;
-                        std::cout << "Level 1 Complete! Starting Level 2...\n";
-                    } else {
-                        gameWon_ = true;
-                        std::cout << "You Win! You completed both levels!\n";
-                    }
-                } else {
-                    // Destroy old leaf
-                    if (leafBody) {
-                        leafBody->destroyPhysicsBody();
-                    }
-                    
-                    // Respawn leaf at random position
-                    ObjectParams leafParams;
-                    leafParams.x = static_cast<float>(rand() % (SCREEN_WIDTH - 90));
-                    leafParams.y = static_cast<float>((SCREEN_HEIGHT / 2) + rand() % (SCREEN_HEIGHT / 2 - 90));
-                    leafParams.width = 90.0f;
-                    leafParams.height = 90.0f;
-                    leafParams.velocityX = (rand() % 2 == 0 ? 1 : -1) * (80.0f + rand() % 40);  // 80-120 speed
-                    leafParams.velocityY = (rand() % 2 == 0 ? 1 : -1) * (60.0f + rand() % 40);  // 60-100 speed
-                    leaf_ = ObjectFactory::instance().create("Leaf", leafParams);
-                    leaf_->init();
-                    
-                    // Leaf uses simple velocity movement (no physics body)
-                    std::cout << "Leaf respawned at (" << leafParams.x << ", " << leafParams.y << ")\n";
-                }
-            }
-        }
-        
-        // Deactivate if off screen
         if (projectile && projectile->isOffScreen()) {
             acorn->setActive(false);
         }
     }
-
-    // Remove inactive acorns
-    acorns_.erase(
-        std::remove_if(acorns_.begin(), acorns_.end(), 
-            [](const std::unique_ptr<GameObject>& a) { return !a->isActive(); }),
-        acorns_.end()
-    );
     
-    // Update red block if in level 2
-    if (currentLevel_ == 2 && redBlock_) {
-        redBlock_->update(dt);
-        
-        // Check collision between acorns and red block (hit gives 2 points)
-        auto* redBody = redBlock_->getComponent<BodyComponent>();
-        if (redBody) {
-            for (auto& acorn : acorns_) {
-                if (!acorn->isActive()) continue;
-                auto* acornBody = acorn->getComponent<BodyComponent>();
-                if (acornBody) {
-                    if (acornBody->getX() < redBody->getX() + redBody->getWidth() &&
-                        acornBody->getX() + acornBody->getWidth() > redBody->getX() &&
-                        acornBody->getY() < redBody->getY() + redBody->getHeight() &&
-                        acornBody->getY() + acornBody->getHeight() > redBody->getY()) {
-                        
-                        // Apply bounce impulse to acorn (same as leaf collision)
-                        if (acornBody->hasPhysicsBody()) {
-                            b2Vec2 currentVel = b2Body_GetLinearVelocity(acornBody->getPhysicsBodyId());
-                            b2Body_SetLinearVelocity(acornBody->getPhysicsBodyId(), {currentVel.x * 0.8f, -currentVel.y * 0.6f});
-                        }
-                        
-                        // Award points only once per acorn
-                        acorn->setActive(false);
-                        hits_ += 2;
-                        score_ += 2;
-                        std::cout << "Red Ball Hit! +2 Points: " << hits_ << "/" << hitsToWin_ << "\n";
-                        
-                        // Check if level complete
-                        if (hits_ >= hitsToWin_) {
-                            gameWon_ = true;
-                            std::cout << "You Win! You completed both levels!\n";
-                        }
-                    }
-                }
-            }
-        }
-    }
+    // Return dead acorns (off screen or hit) to the pool
+    acornPool_.releaseInactive();
     
     // Handle level transition
     if (levelTransition_) {
@@ -440,57 +526,140 @@ void Game::update(float dt) {
     }
 }
 
-void Game::render() {
-    if (gameState_ == GameState::TITLE_SCREEN) {
+// Copy what the renderer needs out of the live objects (simulation thread)
+void Game::publishSnapshot() {
+    RenderSnapshot& frame = frames_.writeBuffer();
+    frame.titleScreen = gameState_ == GameState::TITLE_SCREEN;
+    frame.hud = {nutsRemaining_, hits_, hitsToWin_, currentLevel_, gameOver_, gameWon_};
+    frame.branchY = 0.0f;
+    if (squirrel_) {
+        auto* squirrelBody = squirrel_->getComponent<BodyComponent>();
+        if (squirrelBody) {
+            frame.branchY = squirrelBody->getY() + squirrelBody->getHeight();
+        }
+    }
+    
+    // Both ends of the tick, so the renderer can interpolate on its own clock
+    frame.sprites.clear();
+    for (auto& sprite : ComponentRegistry::instance().pool<SpriteComponent>()) {
+        if (!sprite.getOwner()->isActive()) continue;
+        RenderSnapshot::Sprite entry;
+        if (sprite.getPlacement(0.0f, entry.previous) && sprite.getPlacement(1.0f, entry.current)) {
+            entry.texture = sprite.getTexture();
+            entry.layer = sprite.getLayer();
+            frame.sprites.push_back(entry);
+        }
+    }
+    
+    frame.tick = ++ticks_;
+    frame.tickTime = std::chrono::steady_clock::now();
+    frames_.publish();
+}
+
+// Main thread: draws only from the snapshot, never from live game objects
+void Game::render(const RenderSnapshot& frame, float alpha) {
+    // Render targets may be wiped (device reset, resize on some backends)
+    if (input_.renderTargetsReset()) {
+        graphics_.markAllLayersDirty();
+    }
+    
+    if (frame.titleScreen) {
         renderTitleScreen();
         return;
     }
     
-    // Clear screen with sky blue background
-    graphics_.clear(135, 206, 235, 255);
+    // Sky and branch never change: one cached copy instead of clear + rect
+    if (graphics_.isLayerDirty(backgroundLayer_) && graphics_.beginLayer(backgroundLayer_)) {
+        drawBackground(frame.branchY);
+        graphics_.endLayer();
+    }
+    graphics_.drawLayer(backgroundLayer_);
+
+    // Queue the visible sprites using view transforms; they are drawn in a few
+    // batched calls when the frame is presented
+    cullSprites(frame, alpha);
+    
+    // All visible sprite centres go through the view matrix in one batched call
+    size_t visibleCount = visibleSprites_.size();
+    spriteCenters_.resize(2 * visibleCount);
+    for (size_t i = 0; i < visibleCount; i++) {
+        const SpriteComponent::Placement& placement = spritePlacements_[visibleSprites_[i]];
+        spriteCenters_[2 * i] = placement.centerX;
+        spriteCenters_[2 * i + 1] = placement.centerY;
+    }
+    view_.worldToScreen(spriteCenters_.data(), spriteCenters_.data(), visibleCount);
+    for (size_t i = 0; i < visibleCount; i++) {
+        uint32_t index = visibleSprites_[i];
+        const RenderSnapshot::Sprite& sprite = frame.sprites[index];
+        SpriteComponent::submit(graphics_.getSpriteBatch(), graphics_.getRegion(sprite.texture), sprite.layer,
+                                spritePlacements_[index], spriteCenters_[2 * i], spriteCenters_[2 * i + 1], view_);
+    }
 
-    // Draw brown branch at top
-    auto* squirrelBody = squirrel_->getComponent<BodyComponent>();
-    if (squirrelBody) {
-        graphics_.drawFilledRect(0, static_cast<int>(squirrelBody->getY() + squirrelBody->getHeight()), 
-                                SCREEN_WIDTH, 20, 139, 69, 19, 255);
+    // HUD is redrawn only when one of the values it shows changes
+    if (!(frame.hud == drawnHud_)) {
+        graphics_.markLayerDirty(hudLayer_);
     }
+    if (graphics_.isLayerDirty(hudLayer_) && graphics_.beginLayer(hudLayer_)) {
+        drawHud(frame.hud);
+        graphics_.endLayer();
+        drawnHud_ = frame.hud;
+    }
+    graphics_.drawLayer(hudLayer_);
 
-    // Render game objects using view transforms
-    squirrel_->render(&view_);
-    
-    for (const auto& acorn : acorns_) {
-        acorn->render(&view_);
+    // Present the rendered frame
+    graphics_.present();
+}
+
+// Culling: every active sprite's world box (rotation included) goes into a
+// uniform grid, and only the sprites the view rectangle touches are kept
+void Game::cullSprites(const RenderSnapshot& frame, float alpha) {
+    spriteGrid_.clear();
+    spritePlacements_.resize(frame.sprites.size());
+    for (uint32_t index = 0; index < frame.sprites.size(); index++) {
+        const RenderSnapshot::Sprite& sprite = frame.sprites[index];
+        SpriteComponent::Placement& placement = spritePlacements_[index];
+        placement = SpriteComponent::interpolate(sprite.previous, sprite.current, alpha);
+        spriteGrid_.insert(index, SpriteComponent::getWorldBounds(placement));
     }
+    spriteGrid_.build();
     
-    leaf_->render(&view_);
+    Aabb viewBounds;
+    view_.getWorldBounds(viewBounds.minX, viewBounds.minY, viewBounds.maxX, viewBounds.maxY);
+    visibleSprites_.clear();
+    spriteGrid_.query(viewBounds, visibleSprites_);  // Ascending, so pool order is kept
     
-    // Render red bird sprite if in level 2
-    if (currentLevel_ == 2 && redBlock_) {
-        redBlock_->render(&view_);
-    }
+    cullStats_.drawn = static_cast<int>(visibleSprites_.size());
+    cullStats_.culled = static_cast<int>(spriteGrid_.size() - visibleSprites_.size());
+    cullStats_.totalDrawn += cullStats_.drawn;
+    cullStats_.totalCulled += cullStats_.culled;
+}
 
-    // Draw acorn icons for remaining nuts (top left)
+void Game::drawBackground(float branchY) {
+    // Sky blue background
+    graphics_.drawFilledRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 135, 206, 235, 255);
+
+    // Brown branch at top, under the squirrel (which only moves sideways)
+    graphics_.drawFilledRect(0, static_cast<int>(branchY), SCREEN_WIDTH, 20, 139, 69, 19, 255);
+}
+
+void Game::drawHud(const HudState& hud) {
+    // Acorn icons for remaining nuts (top left), batched on the HUD layer
     int acornIconSize = 25;
-    for (int i = 0; i < nutsRemaining_; i++) {
-        graphics_.drawTexture(graphics_.getTexture("acorn"), 
-                            10 + i * (acornIconSize + 5), 10, acornIconSize, acornIconSize);
+    for (int i = 0; i < hud.nuts; i++) {
+        graphics_.drawSprite(acornIcon_, static_cast<float>(10 + i * (acornIconSize + 5)), 10.0f,
+                             static_cast<float>(acornIconSize), static_cast<float>(acornIconSize),
+                             0.0f, Graphics::HUD_LAYER);
     }
 
-    // Draw UI text
-    drawText("Level " + std::to_string(currentLevel_), SCREEN_WIDTH / 2 - 40, 10);
-    drawText("Points: " + std::to_string(hits_) + "/" + std::to_string(hitsToWin_), SCREEN_WIDTH - 130, 10);
+    // UI text
+    drawText("Level " + std::to_string(hud.level), SCREEN_WIDTH / 2 - 40, 10);
+    drawText("Points: " + std::to_string(hud.hits) + "/" + std::to_string(hud.hitsToWin), SCREEN_WIDTH - 130, 10);
     
-
-    
-    if (gameOver_) {
+    if (hud.gameOver) {
         drawText("GAME OVER!", SCREEN_WIDTH / 2 - 80, SCREEN_HEIGHT / 2);
-    } else if (gameWon_) {
+    } else if (hud.gameWon) {
         drawText("YOU WIN!", SCREEN_WIDTH / 2 - 70, SCREEN_HEIGHT / 2);
     }
-
-    // Present the rendered frame
-    graphics_.present();
 }
 
 void Game::drawText(const std::string& text, int x, int y) {
@@ -498,8 +667,26 @@ void Game::drawText(const std::string& text, int x, int y) {
 }
 
 void Game::renderTitleScreen() {
-    // Clear with pale green background
-    graphics_.clear(144, 238, 144, 255);
+    // Nothing on the title screen changes, so it is rendered once and copied
+    if (graphics_.isLayerDirty(titleLayer_) && graphics_.beginLayer(titleLayer_)) {
+        drawTitleCard();
+        graphics_.endLayer();
+    }
+    graphics_.drawLayer(titleLayer_);
+
+    // Cover the play prompt with loading progress until assets are ready
+    if (assetLoader_) {
+        graphics_.drawFilledRect(0, 505, SCREEN_WIDTH, 50, 144, 238, 144, 255);
+        int percent = static_cast<int>(assetLoader_->getProgress() * 100.0f);
+        drawText("Loading... " + std::to_string(percent) + "%", SCREEN_WIDTH / 2 - 80, 520);
+    }
+    
+    graphics_.present();
+}
+
+void Game::drawTitleCard() {
+    // Pale green background
+    graphics_.drawFilledRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 144, 238, 144, 255);
     
     // Game title
     drawText("SQUIRREL ACORN GAME", SCREEN_WIDTH / 2 - 150, 100);
@@ -517,8 +704,6 @@ void Game::renderTitleScreen() {
     
     // Play prompt
     drawText("Press SPACE or ENTER to Play", SCREEN_WIDTH / 2 - 180, 520);
-    
-    graphics_.present();
 }
 
 void Game::startLevel2() {
@@ -527,60 +712,145 @@ void Game::startLevel2() {
     hitsToWin_ = LEVEL2_HITS; // Double the points needed
     nutsRemaining_ = 10 + LEVEL2_EXTRA_NUTS; // Replenish acorns to full + bonus
     
-    // Clear existing acorns
-    acorns_.clear();
-    
-    // Respawn leaf with faster speed
-    ObjectParams leafParams;
-    leafParams.x = 400.0f;
-    leafParams.y = 500.0f;
-    leafParams.width = 90.0f;
-    leafParams.height = 90.0f;
-    leafParams.velocityX = leafSpeedX_ * 0.7f; // Moderate speed for level 2
-    leafParams.velocityY = leafSpeedY_ * 0.7f;
-    leaf_ = ObjectFactory::instance().create("Leaf", leafParams);
-    leaf_->init();
+    // Park any acorns still in flight
+    acornPool_.releaseAll();
     
-    // Leaf uses simple velocity movement (no physics body)
-    
-    // Create red circle obstacle (1.25x faster than leaf)
-    ObjectParams redParams;
-    redParams.x = static_cast<float>(rand() % (SCREEN_WIDTH - 60));
-    redParams.y = static_cast<float>((SCREEN_HEIGHT / 2) + rand() % (SCREEN_HEIGHT / 2 - 60));
-    redParams.width = 60.0f;
-    redParams.height = 60.0f;
-    redParams.velocityX = (rand() % 2 == 0 ? 1 : -1) * (leafSpeedX_ * 1.25f + rand() % 50); // 1.25x speed
-    redParams.velocityY = (rand() % 2 == 0 ? 1 : -1) * (leafSpeedY_ * 1.25f + rand() % 50);
-    redBlock_ = ObjectFactory::instance().create("RedBlock", redParams);
-    redBlock_->init();
+    // Move the leaf back to the middle with faster speed (moderate speed for level 2)
+    placeTarget(*leaf_, 400.0f, 500.0f, leafSpeedX_ * 0.7f, leafSpeedY_ * 0.7f);
     
-    // Red bird uses simple velocity movement (no physics body), same as leaf
+    // Bring in the red circle obstacle (1.25x faster than leaf), parked since level 1
+    placeTarget(*redBlock_,
+                static_cast<float>(rand() % (SCREEN_WIDTH - 60)),
+                static_cast<float>((SCREEN_HEIGHT / 2) + rand() % (SCREEN_HEIGHT / 2 - 60)),
+                (rand() % 2 == 0 ? 1 : -1) * (leafSpeedX_ * 1.25f + rand() % 50),
+                (rand() % 2 == 0 ? 1 : -1) * (leafSpeedY_ * 1.25f + rand() % 50));
+    redBlock_->setActive(true);
+    redBlock_->getComponent<BodyComponent>()->setPhysicsEnabled(true);
     
+    captureLevelStart();
     std::cout << "Level 2 Started! Points needed: " << hitsToWin_ << ", Nuts: " << nutsRemaining_ << "\n";
 }
 
-void Game::handleCollision(void* bodyA, void* bodyB) {
-    // Cast back to BodyComponents
-    BodyComponent* compA = static_cast<BodyComponent*>(bodyA);
-    BodyComponent* compB = static_cast<BodyComponent*>(bodyB);
-    
-    if (!compA || !compB) return;
+void Game::respawnLeaf() {
+    // Respawn leaf at random position (the same leaf and body, moved)
+    float x = static_cast<float>(rand() % (SCREEN_WIDTH - 90));
+    float y = static_cast<float>((SCREEN_HEIGHT / 2) + rand() % (SCREEN_HEIGHT / 2 - 90));
+    float vx = (rand() % 2 == 0 ? 1 : -1) * (80.0f + rand() % 40);  // 80-120 speed
+    float vy = (rand() % 2 == 0 ? 1 : -1) * (60.0f + rand() % 40);  // 60-100 speed
+    placeTarget(*leaf_, x, y, vx, vy);
     
-    // Get parent GameObjects
-    GameObject* objA = &compA->parent();
-    GameObject* objB = &compB->parent();
+    std::cout << "Leaf respawned at (" << x << ", " << y << ")\n";
+}
+
+void Game::placeTarget(GameObject& target, float x, float y, float velocityX, float velocityY) {
+    auto* body = target.getComponent<BodyComponent>();
+    if (!body) return;
+    body->setPosition(x, y);
+    body->setVelocity(velocityX, velocityY);
+    body->resetInterpolation();  // Teleport, don't slide across the screen
+    body->syncToPhysics();       // Move the kinematic sensor along with it
+}
+
+// Level restart: the whole simulation state is captured in place when a level
+// starts, and restoring it puts every object back without re-creating anything
+void Game::captureLevelStart() {
+    auto start = std::chrono::steady_clock::now();
+    levelStartState_.clear();
+    saveState(levelStartState_);
+    float micros = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Level snapshot: " << levelStartState_.size() << " bytes in " << micros << " us\n";
+}
+
+void Game::restartLevel() {
+    auto start = std::chrono::steady_clock::now();
+    if (!restoreState(levelStartState_)) {
+        std::cerr << "Level restart failed: snapshot does not match the current objects\n";
+        return;
+    }
+    float micros = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Level " << currentLevel_ << " restarted in " << micros << " us\n";
+}
+
+void Game::saveState(std::vector<uint8_t>& buffer) {
+    SnapshotWriter writer(buffer);
+    
+    // Game counters
+    writer.write(static_cast<int32_t>(currentLevel_));
+    writer.write(static_cast<int32_t>(hits_));
+    writer.write(static_cast<int32_t>(hitsToWin_));
+    writer.write(static_cast<int32_t>(score_));
+    writer.write(static_cast<int32_t>(nutsRemaining_));
+    writer.write(acornCooldown_);
+    uint8_t flags = (gameOver_ ? 1 : 0) | (gameWon_ ? 2 : 0) | (redBlock_->isActive() ? 4 : 0);
+    writer.write(flags);
+    
+    physicsWorld_.saveSnapshot(writer);
+    acornPool_.saveState(writer);
+}
+
+bool Game::restoreState(const std::vector<uint8_t>& buffer) {
+    SnapshotReader reader(buffer);
+    
+    int32_t level = 0, hits = 0, hitsToWin = 0, score = 0, nuts = 0;
+    float cooldown = 0.0f;
+    uint8_t flags = 0;
+    reader.read(level);
+    reader.read(hits);
+    reader.read(hitsToWin);
+    reader.read(score);
+    reader.read(nuts);
+    reader.read(cooldown);
+    reader.read(flags);
+    if (!reader.ok()) return false;
+    
+    // Every section is read and validated before any is applied, so a stale
+    // or truncated snapshot is rejected with the game untouched
+    if (!physicsWorld_.readSnapshot(reader) || !acornPool_.readState(reader)) {
+        return false;
+    }
+    physicsWorld_.applySnapshot();
+    acornPool_.applyState();
+    
+    currentLevel_ = level;
+    hits_ = hits;
+    hitsToWin_ = hitsToWin;
+    score_ = score;
+    nutsRemaining_ = nuts;
+    acornCooldown_ = cooldown;
+    gameOver_ = (flags & 1) != 0;
+    gameWon_ = (flags & 2) != 0;
+    redBlock_->setActive((flags & 4) != 0);
+    levelTransition_ = false;
+    leafRespawnPending_ = false;
+    return true;
+}
+
+void Game::handleContacts(const std::vector<ContactEvent>& events) {
+    for (const ContactEvent& event : events) {
+        // Solid touches and target (sensor) overlaps both score; ends and hits don't
+        if (event.type == ContactEvent::Type::Begin ||
+            event.type == ContactEvent::Type::SensorBegin) {
+            handleCollision(event.bodyA->parent(), event.bodyB->parent());
+        }
+    }
     
-    std::cout << "Collision: " << objA->getName() << " <-> " << objB->getName() << "\n";
+    // Respawn once the whole batch is handled, so every event in it sees the
+    // leaf where it was during the step
+    if (leafRespawnPending_) {
+        leafRespawnPending_ = false;
+        respawnLeaf();
+    }
+}
+
+void Game::handleCollision(GameObject& objA, GameObject& objB) {
+    std::cout << "Collision: " << objA.getName() << " <-> " << objB.getName() << "\n";
     
-    // Check if collision is between acorn and leaf
-    bool isAcornLeaf = (objA->getName() == "Acorn" && objB->getName() == "Leaf") ||
-                       (objA->getName() == "Leaf" && objB->getName() == "Acorn");
+    // Find which object is the acorn (if any)
+    GameObject* acorn = objA.getTag() == ObjectTag::Acorn ? &objA : &objB;
     
-    if (isAcornLeaf) {
-        // Find which is acorn and which is leaf
-        GameObject* acorn = (objA->getName() == "Acorn") ? objA : objB;
-        
-        acorn->setActive(false);
+    switch (collisionKey(objA.getTag(), objB.getTag())) {
+    case collisionKey(ObjectTag::Acorn, ObjectTag::Leaf):
+        bounceAcorn(*acorn);
         hits_++;
         score_++;
         std::cout << "Hit! Points: " << hits_ << "/" << hitsToWin_ << "\n";
@@ -594,38 +864,16 @@ void Game::handleCollision(void* bodyA, void* bodyB) {
                 std::cout << "You Win! You completed both levels!\n";
             }
         } else {
-            // Respawn leaf
-            auto* leafBody = leaf_->getComponent<BodyComponent>();
-            if (leafBody) {
-                leafBody->destroyPhysicsBody();
-            }
-            
-            ObjectParams leafParams;
-            leafParams.x = static_cast<float>(rand() % (SCREEN_WIDTH - 90));
-            leafParams.y = static_cast<float>((SCREEN_HEIGHT / 2) + rand() % (SCREEN_HEIGHT / 2 - 90));
-            leafParams.width = 90.0f;
-            leafParams.height = 90.0f;
-            leafParams.velocityX = (rand() % 2 == 0 ? 1 : -1) * (80.0f + rand() % 40);  // 80-120 speed
-            leafParams.velocityY = (rand() % 2 == 0 ? 1 : -1) * (60.0f + rand() % 40);  // 60-100 speed
-            leaf_ = ObjectFactory::instance().create("Leaf", leafParams);
-            leaf_->init();
-            
-            auto* newLeafBody = leaf_->getComponent<BodyComponent>();
-            if (newLeafBody) {
-                newLeafBody->createPhysicsBody(&physicsWorld_, b2_dynamicBody, 0.5f, 0.0f, 0.3f);
-                newLeafBody->syncToPhysics();
-            }
-            std::cout << "Leaf respawned at (" << leafParams.x << ", " << leafParams.y << ")\n";
+            leafRespawnPending_ = true;
         }
-    }
-    
-    // Check acorn-redbird collision for level 2
-    bool isAcornRed = (objA->getName() == "Acorn" && objB->getName() == "RedBlock") ||
-                      (objA->getName() == "RedBlock" && objB->getName() == "Acorn");
-    
-    if (isAcornRed && currentLevel_ == 2) {
-        GameObject* acorn = (objA->getName() == "Acorn") ? objA : objB;
+        break;
+        
+    // Acorn-redbird collision for level 2
+    case collisionKey(ObjectTag::Acorn, ObjectTag::RedBlock):
+        if (currentLevel_ != 2) break;
         
+        // Award points only once per acorn
+        bounceAcorn(*acorn);
         acorn->setActive(false);
         hits_ += 2;
         score_ += 2;
@@ -635,6 +883,19 @@ void Game::handleCollision(void* bodyA, void* bodyB) {
             gameWon_ = true;
             std::cout << "You Win! You completed both levels!\n";
         }
+        break;
+        
+    default:
+        break;
     }
 }
 
+void Game::bounceAcorn(GameObject& acorn) {
+    // BOX2D REQUIREMENT: Linear velocity manipulation for bounce effect
+    // Reverse vertical velocity and dampen (60% of original speed, 80% horizontal)
+    auto* body = acorn.getComponent<BodyComponent>();
+    if (body && body->hasPhysicsBody()) {
+        b2Vec2 currentVel = b2Body_GetLinearVelocity(body->getPhysicsBodyId());
+        b2Body_SetLinearVelocity(body->getPhysicsBodyId(), {currentVel.x * 0.8f, -currentVel.y * 0.6f});
+    }
+}
@@ -1,17 +1,37 @@
 #pragma once
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 #include <unordered_map>
 #include "GameObject.h"
+#include "ObjectFactory.h"
 #include "Graphics.h"
 #include "Input.h"
 #include "View.h"
 #include "PhysicsWorld.h"
+#include "ProjectilePool.h"
+#include "SpatialGrid.h"
+#include "SpriteComponent.h"
+#include "RenderSnapshot.h"
+#include "TripleBuffer.h"
+#include "FramePacer.h"
+#include "TaskSystem.h"
+#include "AssetLoader.h"
+#include "AssetArchive.h"
+#include "GameConfig.h"
 
 class Game {
 public:
-    int run();
+    // Command-line overrides (see main.cpp)
+    struct LaunchOptions {
+        bool headless = false;    // Offscreen software rendering, no window
+        std::string fontPath;     // Overrides the config / platform default
+        long long maxFrames = 0;  // Quit after this many frames (0 = run until closed)
+    };
+
+    int run(const LaunchOptions& options);
 private:
     enum class GameState {
         TITLE_SCREEN,
@@ -21,38 +41,74 @@ private:
 
     bool init();
     void shutdown();
+    void simulationLoop();
+    void tick(float dt);
     void update(float dt);
-    void render();
+    void publishSnapshot();
+    void render(const RenderSnapshot& frame, float alpha);
     void renderTitleScreen();
-    void handleInput();
+    void drawTitleCard();
+    void drawBackground(float branchY);
+    void drawHud(const HudState& hud);
+    void cullSprites(const RenderSnapshot& frame, float alpha);
+    void handleInput(float dt);
     bool loadConfig(const std::string& path);
+    void applyConfig(const GameConfig& config);
+    bool loadPackedAssets();
+    bool loadFont();
     void drawText(const std::string& text, int x, int y);
-    void registerObjectTypes();
+    bool setupPrototypes();
     void createGameObjects();
+    void createAcornPool();
     GameObject* spawnAcorn(float x, float y);
     void startLevel2();
-    void handleCollision(void* bodyA, void* bodyB);
+    void respawnLeaf();
+    void handleContacts(const std::vector<ContactEvent>& events);
+    void handleCollision(GameObject& objA, GameObject& objB);
+    void bounceAcorn(GameObject& acorn);
+    void placeTarget(GameObject& target, float x, float y, float velocityX, float velocityY);
+    
+    // Simulation state snapshots (level restart, rollback)
+    void saveState(std::vector<uint8_t>& buffer);
+    bool restoreState(const std::vector<uint8_t>& buffer);
+    void captureLevelStart();
+    void restartLevel();
 
     Graphics graphics_;
     Input input_;
     View view_;
+    std::unique_ptr<TaskSystem> taskSystem_;  // Declared before the world so it outlives it
     PhysicsWorld physicsWorld_;
 
-    std::unique_ptr<GameObject> squirrel_;
-    std::vector<std::unique_ptr<GameObject>> acorns_;
-    std::unique_ptr<GameObject> leaf_;
-    std::unique_ptr<GameObject> redBlock_;
+    // Object prototypes from objects.xml, looked up once
+    ObjectFactory::PrototypeId squirrelType_ = ObjectFactory::INVALID_PROTOTYPE;
+    ObjectFactory::PrototypeId leafType_ = ObjectFactory::INVALID_PROTOTYPE;
+    ObjectFactory::PrototypeId acornType_ = ObjectFactory::INVALID_PROTOTYPE;
+    ObjectFactory::PrototypeId redBlockType_ = ObjectFactory::INVALID_PROTOTYPE;
+    TextureHandle acornIcon_;  // HUD nut counter
+
+    ObjectPtr squirrel_;
+    ProjectilePool acornPool_;
+    ObjectPtr leaf_;
+    ObjectPtr redBlock_;
 
     // Configuration values
     float squirrelSpeed_ = 300.0f;
     float acornSpeed_ = 400.0f;
-    float acornWidth_ = 30.0f;
+    float acornWidth_ = 30.0f;         // From the Acorn prototype
     float acornHeight_ = 30.0f;
     float leafSpeedX_ = 200.0f;
     float leafSpeedY_ = 150.0f;
+    int acornPoolSize_ = 64;           // Acorns pre-created at level start
+    float acornCooldownTime_ = 1.0f;   // Seconds between shots (0 = uncapped)
+    int physicsWorkers_ = 1;           // Threads stepping Box2D (0 = one per hardware thread)
 
     float acornCooldown_ = 0.0f;
-    static constexpr float ACORN_COOLDOWN_TIME = 1.0f;
+    
+    // Physics statistics (reported at shutdown)
+    long long physicsSteps_ = 0;
+    long long physicsSyncedBodies_ = 0;
+    int maxSyncedBodies_ = 0;
 
     int nutsRemaining_ = 10;
     int hits_ = 0;
@@ -65,6 +121,47 @@ private:
     bool gameOver_ = false;
     bool gameWon_ = false;
     bool levelTransition_ = false;
+    bool leafRespawnPending_ = false;
+    std::vector<uint8_t> levelStartState_;  // Restored by R
+
+    // Cached render layers (Graphics layer ids); redrawn only when dirty
+    int backgroundLayer_ = -1;  // Sky and branch
+    int titleLayer_ = -1;       // Whole title screen
+    int hudLayer_ = -1;         // Nut icons, level, points, end message
+    HudState drawnHud_ = {-1, -1, -1, -1, false, false};
+
+    // Simulation/render split: the simulation thread ticks and publishes a
+    // RenderSnapshot per tick; the main thread pumps events and renders the
+    // latest one. Nothing else is shared except the input event queue.
+    TripleBuffer<RenderSnapshot> frames_;
+    std::atomic<bool> simulationRunning_{false};
+    KeySnapshot keys_;            // Simulation thread: keys for the current tick
+    uint64_t ticks_ = 0;          // Simulation thread
+    struct FrameStats {
+        long long frames = 0;          // Rendered
+        long long repeatedFrames = 0;  // Rendered with no new tick since the last frame
+        long long skippedTicks = 0;    // Published but overwritten before being rendered
+    };
+    FrameStats frameStats_;       // Main thread
+
+    // Startup assets load in the background behind the title screen; the
+    // simulation only leaves the title screen once they are ready
+    std::unique_ptr<AssetLoader> assetLoader_;  // Main thread; null once loaded
+    AssetArchive archive_;  // assets.pak, when present; mapped only during startup
+    std::atomic<bool> assetsReady_{false};
+
+    // View culling: sprite world boxes indexed per frame (buffers reused)
+    SpatialGrid spriteGrid_;
+    std::vector<uint32_t> visibleSprites_;  // Snapshot sprite indices
+    std::vector<SpriteComponent::Placement> spritePlacements_;  // Per snapshot sprite, this frame
+    std::vector<float> spriteCenters_;      // Visible centres, world then screen (x,y pairs)
+    struct CullStats {
+        int drawn = 0;    // Last frame
+        int culled = 0;
+        long long totalDrawn = 0;
+        long long totalCulled = 0;
+    };
+    CullStats cullStats_;
 
     int score_ = 0;
     std::string title_ = "Squirrel Acorn Game";
@@ -76,7 +173,15 @@ private:
     static constexpr int SCREEN_WIDTH = 800;
     static constexpr int SCREEN_HEIGHT = 600;
     
-    // Frame rate limiting
-    static constexpr int TARGET_FPS = 60;
-    static constexpr float TARGET_FRAME_TIME = 1000.0f / TARGET_FPS;  // milliseconds
+    // Timing: fixed simulation rate; the render rate is paced separately
+    // (maxFps 0 = display rate)
+    float tickRate_ = 60.0f;
+    float maxFps_ = 60.0f;
+    FramePacer::Mode frameMode_ = FramePacer::Mode::Auto;
+    
+    LaunchOptions options_;
+    std::string fontPath_;  // From config; empty = try the platform defaults
+    static constexpr int FONT_SIZE = 24;
+    FramePacer pacer_;
+    static constexpr int MAX_CATCH_UP_TICKS = 5;  // Beyond this, late ticks are dropped
 };
@@ -0,0 +1,64 @@
+#include "GameConfig.h"
+#include "Snapshot.h"
+#include <tinyxml2.h>
+#include <iostream>
+
+bool GameConfig::loadXML(const std::string& path) {
+    tinyxml2::XMLDocument doc;
+    if (doc.LoadFile(path.c_str()) != tinyxml2::XML_SUCCESS) {
+        std::cerr << "Failed to load XML: " << path << "\n";
+        return false;
+    }
+    auto* root = doc.RootElement();
+    if (!root) return false;
+    if (const char* t = root->Attribute("title")) title = t;
+    root->QueryFloatAttribute("squirrelSpeed", &squirrelSpeed);
+    root->QueryFloatAttribute("acornSpeed", &acornSpeed);
+    root->QueryFloatAttribute("leafSpeedX", &leafSpeedX);
+    root->QueryFloatAttribute("leafSpeedY", &leafSpeedY);
+    root->QueryIntAttribute("acornPoolSize", &acornPoolSize);
+    root->QueryFloatAttribute("acornCooldown", &acornCooldown);
+    root->QueryIntAttribute("physicsWorkers", &physicsWorkers);
+    root->QueryFloatAttribute("tickRate", &tickRate);
+    root->QueryFloatAttribute("maxFps", &maxFps);
+    if (const char* f = root->Attribute("font")) font = f;
+    if (const char* mode = root->Attribute("frameMode")) frameMode = mode;
+    return true;
+}
+
+void GameConfig::write(SnapshotWriter& writer) const {
+    writer.write(BINARY_VERSION);
+    writer.writeString(title);
+    writer.write(squirrelSpeed);
+    writer.write(acornSpeed);
+    writer.write(leafSpeedX);
+    writer.write(leafSpeedY);
+    writer.write(static_cast<int32_t>(acornPoolSize));
+    writer.write(acornCooldown);
+    writer.write(static_cast<int32_t>(physicsWorkers));
+    writer.write(tickRate);
+    writer.write(maxFps);
+    writer.writeString(frameMode);
+    writer.writeString(font);
+}
+
+bool GameConfig::read(SnapshotReader& reader) {
+    uint32_t version = 0;
+    if (!reader.read(version) || version != BINARY_VERSION) return false;
+    int32_t poolSize = 0, workers = 0;
+    reader.readString(title);
+    reader.read(squirrelSpeed);
+    reader.read(acornSpeed);
+    reader.read(leafSpeedX);
+    reader.read(leafSpeedY);
+    reader.read(poolSize);
+    reader.read(acornCooldown);
+    reader.read(workers);
+    reader.read(tickRate);
+    reader.read(maxFps);
+    reader.readString(frameMode);
+    reader.readString(font);
+    acornPoolSize = poolSize;
+    physicsWorkers = workers;
+    return reader.ok();
+}
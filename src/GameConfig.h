@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+class SnapshotWriter;
+class SnapshotReader;
+
+// Values from assets/config.xml. Loaded from the XML, or from the binary
+// record the asset packer stores in assets.pak (no XML parsing at startup).
+// Attributes missing from the XML keep these defaults.
+struct GameConfig {
+    std::string title = "Squirrel Acorn Game";
+    float squirrelSpeed = 300.0f;
+    float acornSpeed = 400.0f;
+    float leafSpeedX = 200.0f;
+    float leafSpeedY = 150.0f;
+    int acornPoolSize = 64;
+    float acornCooldown = 1.0f;
+    int physicsWorkers = 1;
+    float tickRate = 60.0f;
+    float maxFps = 60.0f;
+    std::string frameMode = "auto";
+    std::string font;
+
+    bool loadXML(const std::string& path);
+
+    // Binary record, in field order
+    static constexpr uint32_t BINARY_VERSION = 1;
+    void write(SnapshotWriter& writer) const;
+    bool read(SnapshotReader& reader);
+};
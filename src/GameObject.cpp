@@ -1,50 +1,96 @@
 #include "GameObject.h"
 #include "SpriteComponent.h"
 #include "View.h"
+#include <iterator>
 
-GameObject::GameObject(const std::string& name) : name_(name), active_(true) {
+namespace {
+constexpr std::string_view TAG_NAMES[static_cast<size_t>(ObjectTag::Count)] = {
+    "None",
+    "Squirrel",
+    "Leaf",
+    "Acorn",
+    "RedBlock"
+};
 }
 
-void GameObject::addComponent(std::unique_ptr<Component> component) {
-    component->setOwner(this);
-    components_.push_back(std::move(component));
+const char* objectTagName(ObjectTag tag) {
+    size_t index = static_cast<size_t>(tag);
+    return index < std::size(TAG_NAMES) ? TAG_NAMES[index].data() : "Unknown";
 }
 
-Component* GameObject::getComponent(const std::string& type) {
-    for (auto& comp : components_) {
-        if (comp->getType() == type) {
-            return comp.get();
+bool findObjectTag(std::string_view name, ObjectTag& tag) {
+    for (size_t i = 0; i < std::size(TAG_NAMES); i++) {
+        if (name == TAG_NAMES[i]) {
+            tag = static_cast<ObjectTag>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+GameObject::GameObject(std::string_view name) : name_(name), active_(true) {
+}
+
+GameObject::~GameObject() {
+    removeComponents();
+}
+
+void GameObject::removeComponents() {
+    if (!mask_) return;
+    auto& registry = ComponentRegistry::instance();
+    for (size_t i = 0; i < MAX_COMPONENT_TYPES; i++) {
+        if (mask_ & componentBit(static_cast<ComponentType>(i))) {
+            registry.remove(static_cast<ComponentType>(i), slots_[i]);
         }
     }
-    return nullptr;
+    mask_ = 0;
+}
+
+Component* GameObject::slotComponent(size_t index) const {
+    if (!(mask_ & componentBit(static_cast<ComponentType>(index)))) return nullptr;
+    return ComponentRegistry::instance().get(static_cast<ComponentType>(index), slots_[index]);
+}
+
+Component* GameObject::getComponent(const std::string& type) {
+    ComponentType typeId;
+    if (!ComponentRegistry::findType(type, typeId)) return nullptr;
+    return slotComponent(static_cast<size_t>(typeId));
 }
 
 void GameObject::init() {
-    for (auto& comp : components_) {
-        comp->init();
+    for (size_t i = 0; i < MAX_COMPONENT_TYPES; i++) {
+        if (Component* comp = slotComponent(i)) {
+            comp->init();
+        }
     }
 }
 
 void GameObject::update(float dt) {
     if (!active_) return;
-    for (auto& comp : components_) {
-        comp->update(dt);
+    for (size_t i = 0; i < MAX_COMPONENT_TYPES; i++) {
+        if (Component* comp = slotComponent(i)) {
+            comp->update(dt);
+        }
     }
 }
 
 void GameObject::render() {
     if (!active_) return;
-    for (auto& comp : components_) {
-        comp->render();
+    for (size_t i = 0; i < MAX_COMPONENT_TYPES; i++) {
+        if (Component* comp = slotComponent(i)) {
+            comp->render();
+        }
     }
 }
 
-void GameObject::render(const View* view) {
+void GameObject::render(SpriteBatch& batch, const View* view) {
     if (!active_) return;
-    for (auto& comp : components_) {
-        // Check if component is a SpriteComponent and use view-based rendering
-        if (auto* sprite = dynamic_cast<SpriteComponent*>(comp.get())) {
-            sprite->render(view);
+    for (size_t i = 0; i < MAX_COMPONENT_TYPES; i++) {
+        Component* comp = slotComponent(i);
+        if (!comp) continue;
+        // Sprites use view-based, batched rendering
+        if (i == ComponentRegistry::typeIndex<SpriteComponent>()) {
+            static_cast<SpriteComponent*>(comp)->render(batch, view);
         } else {
             comp->render();
         }
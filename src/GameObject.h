@@ -1,44 +1,126 @@
 #pragma once
+#include <array>
 #include <memory>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include "Component.h"
+#include "ComponentRegistry.h"
 
 class View;
+class SpriteBatch;
 
+// Integer object kind, used to key collision handling without string compares
+enum class ObjectTag : uint8_t {
+    None,
+    Squirrel,
+    Leaf,
+    Acorn,
+    RedBlock,
+    Count
+};
+
+// Name <-> tag mapping for data-driven objects (objects.xml tag="...")
+const char* objectTagName(ObjectTag tag);
+bool findObjectTag(std::string_view name, ObjectTag& tag);
+
+// Order-independent key for a pair of tags, for switching on collision pairs
+constexpr uint16_t collisionKey(ObjectTag a, ObjectTag b) {
+    uint16_t x = static_cast<uint16_t>(a);
+    uint16_t y = static_cast<uint16_t>(b);
+    return x < y ? static_cast<uint16_t>((x << 8) | y) : static_cast<uint16_t>((y << 8) | x);
+}
+
+// A GameObject is a lightweight handle table: its components live in the
+// per-type pools of the ComponentRegistry, one slot per ComponentType.
+// The name is not copied: it must outlive the object (a literal, or the type
+// of the ObjectFactory prototype the object was created from).
 class GameObject {
 public:
-    GameObject(const std::string& name = "GameObject");
-    ~GameObject() = default;
+    GameObject(std::string_view name = "GameObject");
+    ~GameObject();
+
+    GameObject(const GameObject&) = delete;
+    GameObject& operator=(const GameObject&) = delete;
 
-    void addComponent(std::unique_ptr<Component> component);
+    // Construct a component of type T in its pool and attach it to this object
+    // (replacing any existing T). The returned pointer is only valid until the
+    // next add/remove on that pool.
+    template<typename T, typename... Args>
+    T* addComponent(Args&&... args) {
+        constexpr size_t index = ComponentRegistry::typeIndex<T>();
+        auto& pool = ComponentRegistry::instance().pool<T>();
+        if (hasComponent<T>()) {
+            pool.remove(slots_[index]);
+        }
+        slots_[index] = pool.add(std::forward<Args>(args)...);
+        mask_ |= componentBit(T::TYPE);
+        T* component = pool.get(slots_[index]);
+        component->setOwner(this);
+        return component;
+    }
     
     template<typename T>
     T* getComponent() {
-        for (auto& comp : components_) {
-            if (T* result = dynamic_cast<T*>(comp.get())) {
-                return result;
-            }
-        }
-        return nullptr;
+        if (!hasComponent<T>()) return nullptr;
+        return ComponentRegistry::instance().pool<T>().get(slots_[ComponentRegistry::typeIndex<T>()]);
     }
 
+    template<typename T>
+    bool hasComponent() const { return (mask_ & componentBit(T::TYPE)) != 0; }
+
+    bool hasComponents(ComponentMask mask) const { return (mask_ & mask) == mask; }
+    ComponentMask getComponentMask() const { return mask_; }
+
     Component* getComponent(const std::string& type);
 
+    // Hand every component back to its pool
+    void removeComponents();
+
     void init();
     void update(float dt);
     void render();
-    void render(const View* view);
+    void render(SpriteBatch& batch, const View* view);
+
+    std::string_view getName() const { return name_; }
+    void setName(std::string_view name) { name_ = name; }
 
-    const std::string& getName() const { return name_; }
-    void setName(const std::string& name) { name_ = name; }
+    ObjectTag getTag() const { return tag_; }
+    void setTag(ObjectTag tag) { tag_ = tag; }
 
     bool isActive() const { return active_; }
     void setActive(bool active) { active_ = active; }
 
 private:
-    std::string name_;
-    std::vector<std::unique_ptr<Component>> components_;
+    friend class ObjectFactory;  // Attaches a prototype's components in one pass
+
+    // For a fresh object only: build T in its pool without the replace check.
+    // The caller sets mask_ once every component is attached.
+    template<typename T, typename... Args>
+    T* attachComponent(ComponentPool<T>& pool, Args&&... args) {
+        constexpr size_t index = ComponentRegistry::typeIndex<T>();
+        slots_[index] = pool.add(std::forward<Args>(args)...);
+        T* component = pool.get(slots_[index]);
+        component->setOwner(this);
+        return component;
+    }
+
+    Component* slotComponent(size_t index) const;
+
+    std::string_view name_;
+    std::array<ComponentHandle, MAX_COMPONENT_TYPES> slots_;
+    ComponentMask mask_ = 0;
+    ObjectTag tag_ = ObjectTag::None;
     bool active_ = true;
 };
+
+// Defined here because it needs GameObject::isActive()
+template<typename T>
+void ComponentRegistry::updateAll(float dt) {
+    for (auto& component : pool<T>()) {
+        if (component.getOwner() && component.getOwner()->isActive()) {
+            component.update(dt);
+        }
+    }
+}
@@ -0,0 +1,145 @@
+#include "GlyphAtlas.h"
+#include <algorithm>
+#include <iostream>
+
+GlyphAtlas::~GlyphAtlas() {
+    destroy();
+}
+
+int GlyphAtlas::glyphIndex(unsigned char c) {
+    if (c < FIRST_CHAR || c > LAST_CHAR) c = '?';
+    return c - FIRST_CHAR;
+}
+
+bool GlyphAtlas::build(SDL_Renderer* renderer, TTF_Font* font) {
+    destroy();
+    if (!renderer || !font) return false;
+
+    renderer_ = renderer;
+    lineHeight_ = TTF_FontHeight(font);
+
+    // Rasterize each glyph in white; the vertex color tints it when drawn.
+    // A rendered glyph is a full line tall, so quads share the text baseline.
+    const SDL_Color white = {255, 255, 255, 255};
+    std::array<SDL_Surface*, GLYPH_COUNT> surfaces{};
+
+    // Shelf packing: left to right, wrapping to a new row at the atlas width
+    int penX = 0;
+    int penY = 0;
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        Uint32 ch = static_cast<Uint32>(FIRST_CHAR + i);
+        int minX, maxX, minY, maxY, advance;
+        if (TTF_GlyphMetrics32(font, ch, &minX, &maxX, &minY, &maxY, &advance) != 0) {
+            advance = 0;
+        }
+        glyphs_[i].advance = advance;
+
+        surfaces[i] = TTF_RenderGlyph32_Blended(font, ch, white);
+        if (!surfaces[i]) continue;  // e.g. space in some fonts
+
+        int w = surfaces[i]->w;
+        if (penX + w > ATLAS_WIDTH) {
+            penX = 0;
+            penY += lineHeight_ + 1;
+        }
+        glyphs_[i].src = {penX, penY, w, surfaces[i]->h};
+        penX += w + 1;  // One pixel of padding against filtering bleed
+    }
+    atlasWidth_ = ATLAS_WIDTH;
+    atlasHeight_ = penY + lineHeight_ + 1;
+
+    // Compose all glyphs into one surface, then upload it once
+    SDL_Surface* atlas = SDL_CreateRGBSurfaceWithFormat(0, atlasWidth_, atlasHeight_, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!atlas) {
+        std::cerr << "GlyphAtlas: failed to create atlas surface: " << SDL_GetError() << "\n";
+        for (SDL_Surface* surface : surfaces) SDL_FreeSurface(surface);
+        return false;
+    }
+    SDL_FillRect(atlas, nullptr, SDL_MapRGBA(atlas->format, 255, 255, 255, 0));
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        if (!surfaces[i]) continue;
+        SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE);  // Copy alpha as-is
+        SDL_Rect dest = glyphs_[i].src;
+        SDL_BlitSurface(surfaces[i], nullptr, atlas, &dest);
+        SDL_FreeSurface(surfaces[i]);
+    }
+
+    texture_ = SDL_CreateTextureFromSurface(renderer_, atlas);
+    SDL_FreeSurface(atlas);
+    if (!texture_) {
+        std::cerr << "GlyphAtlas: failed to upload atlas: " << SDL_GetError() << "\n";
+        return false;
+    }
+    SDL_SetTextureBlendMode(texture_, SDL_BLENDMODE_BLEND);
+
+    // Kerning pairs are looked up once here rather than per character per frame
+    kerning_.assign(GLYPH_COUNT * GLYPH_COUNT, 0);
+    if (TTF_GetFontKerning(font)) {
+        for (int prev = 0; prev < GLYPH_COUNT; prev++) {
+            for (int cur = 0; cur < GLYPH_COUNT; cur++) {
+                int k = TTF_GetFontKerningSizeGlyphs32(font, FIRST_CHAR + prev, FIRST_CHAR + cur);
+                kerning_[prev * GLYPH_COUNT + cur] = static_cast<int8_t>(std::clamp(k, -128, 127));
+            }
+        }
+    }
+
+    std::cout << "Glyph atlas: " << GLYPH_COUNT << " glyphs in " << atlasWidth_ << "x" << atlasHeight_ << "\n";
+    return true;
+}
+
+void GlyphAtlas::destroy() {
+    if (texture_) {
+        SDL_DestroyTexture(texture_);
+        texture_ = nullptr;
+    }
+    vertices_.clear();
+    indices_.clear();
+}
+
+void GlyphAtlas::addText(std::string_view text, float x, float y, SDL_Color color) {
+    if (!texture_) return;
+
+    const float invW = 1.0f / atlasWidth_;
+    const float invH = 1.0f / atlasHeight_;
+    float penX = x;
+    int prev = -1;
+
+    for (char c : text) {
+        int index = glyphIndex(static_cast<unsigned char>(c));
+        if (prev >= 0) {
+            penX += kerning_[prev * GLYPH_COUNT + index];
+        }
+        prev = index;
+
+        const Glyph& glyph = glyphs_[index];
+        if (glyph.src.w > 0) {
+            float x0 = penX;
+            float y0 = y;
+            float x1 = x0 + glyph.src.w;
+            float y1 = y0 + glyph.src.h;
+            float u0 = glyph.src.x * invW;
+            float v0 = glyph.src.y * invH;
+            float u1 = (glyph.src.x + glyph.src.w) * invW;
+            float v1 = (glyph.src.y + glyph.src.h) * invH;
+
+            int base = static_cast<int>(vertices_.size());
+            vertices_.push_back({{x0, y0}, color, {u0, v0}});
+            vertices_.push_back({{x1, y0}, color, {u1, v0}});
+            vertices_.push_back({{x1, y1}, color, {u1, v1}});
+            vertices_.push_back({{x0, y1}, color, {u0, v1}});
+            indices_.insert(indices_.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+        }
+        penX += glyph.advance;
+    }
+}
+
+bool GlyphAtlas::flush() {
+    if (indices_.empty()) return false;
+
+    SDL_RenderGeometry(renderer_, texture_,
+                       vertices_.data(), static_cast<int>(vertices_.size()),
+                       indices_.data(), static_cast<int>(indices_.size()));
+    vertices_.clear();
+    indices_.clear();
+    return true;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Text rendering from a glyph atlas.
+// Every printable ASCII glyph is rasterized once into a single texture when
+// the font is loaded; strings are then laid out as textured quads (with the
+// font's kerning) and drawn with one SDL_RenderGeometry call per flush, so
+// steady-state text costs no rasterization and no texture uploads.
+class GlyphAtlas {
+public:
+    GlyphAtlas() = default;
+    ~GlyphAtlas();
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+    // Rasterize the glyphs of `font` and upload the atlas texture
+    bool build(SDL_Renderer* renderer, TTF_Font* font);
+    void destroy();
+    bool isReady() const { return texture_ != nullptr; }
+
+    // Lay out `text` with its top-left corner at (x, y) and queue its quads.
+    // Characters outside printable ASCII are drawn as '?'.
+    void addText(std::string_view text, float x, float y, SDL_Color color);
+
+    // Draw everything queued since the last flush in one call.
+    // Returns true if a draw call was issued.
+    bool flush();
+
+    bool hasPending() const { return !indices_.empty(); }
+    int getPendingGlyphs() const { return static_cast<int>(indices_.size() / 6); }
+    int getLineHeight() const { return lineHeight_; }
+
+private:
+    static constexpr int FIRST_CHAR = 32;
+    static constexpr int LAST_CHAR = 126;
+    static constexpr int GLYPH_COUNT = LAST_CHAR - FIRST_CHAR + 1;
+    static constexpr int ATLAS_WIDTH = 512;
+
+    struct Glyph {
+        SDL_Rect src = {0, 0, 0, 0};  // Cell in the atlas (full line height)
+        int advance = 0;
+    };
+
+    static int glyphIndex(unsigned char c);
+
+    SDL_Renderer* renderer_ = nullptr;
+    SDL_Texture* texture_ = nullptr;
+    int atlasWidth_ = 0;
+    int atlasHeight_ = 0;
+    int lineHeight_ = 0;
+    std::array<Glyph, GLYPH_COUNT> glyphs_;
+    std::vector<int8_t> kerning_;  // GLYPH_COUNT x GLYPH_COUNT, [previous][current]
+
+    // Quads queued since the last flush (buffers are reused)
+    std::vector<SDL_Vertex> vertices_;
+    std::vector<int> indices_;
+};
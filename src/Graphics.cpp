@@ -1,5 +1,10 @@
 #include "Graphics.h"
+#include "MipGenerator.h"
 #include <SDL_image.h>
+#include <tinyxml2.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
 
 // Initialize static view pointer
@@ -9,7 +14,12 @@ Graphics::~Graphics() {
     shutdown();
 }
 
-bool Graphics::init(const std::string& title, int width, int height) {
+bool Graphics::init(const std::string& title, int width, int height, bool headless) {
+    headless_ = headless;
+    if (headless_) {
+        // No display needed: the dummy driver satisfies SDL_INIT_VIDEO
+        SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+    }
     if (SDL_Init(SDL_INIT_VIDEO) != 0) {
         std::cerr << "SDL_Init error: " << SDL_GetError() << "\n";
         return false;
@@ -28,40 +38,62 @@ bool Graphics::init(const std::string& title, int width, int height) {
         return false;
     }
 
-    window_ = SDL_CreateWindow(title.c_str(),
-        SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
-        width, height, SDL_WINDOW_SHOWN);
-    if (!window_) {
-        std::cerr << "SDL_CreateWindow error: " << SDL_GetError() << "\n";
-        return false;
-    }
+    if (headless_) {
+        offscreen_ = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888);
+        if (!offscreen_) {
+            std::cerr << "Offscreen surface error: " << SDL_GetError() << "\n";
+            return false;
+        }
+        renderer_ = SDL_CreateSoftwareRenderer(offscreen_);
+        if (!renderer_) {
+            std::cerr << "SDL_CreateSoftwareRenderer error: " << SDL_GetError() << "\n";
+            return false;
+        }
+        std::cout << "Graphics: headless " << width << "x" << height << " software renderer\n";
+    } else {
+        window_ = SDL_CreateWindow(title.c_str(),
+            SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
+            width, height, SDL_WINDOW_SHOWN);
+        if (!window_) {
+            std::cerr << "SDL_CreateWindow error: " << SDL_GetError() << "\n";
+            return false;
+        }
 
-    renderer_ = SDL_CreateRenderer(window_, -1,
-        SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
-    if (!renderer_) {
-        std::cerr << "SDL_CreateRenderer error: " << SDL_GetError() << "\n";
-        return false;
+        renderer_ = SDL_CreateRenderer(window_, -1,
+            SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_TARGETTEXTURE);
+        if (!renderer_) {
+            std::cerr << "SDL_CreateRenderer error: " << SDL_GetError() << "\n";
+            return false;
+        }
     }
+    width_ = width;
+    height_ = height;
 
     return true;
 }
 
 void Graphics::shutdown() {
+    glyphAtlas_.destroy();
+    atlas_.destroy();
+    for (Layer& layer : layers_) {
+        if (layer.texture) SDL_DestroyTexture(layer.texture);
+    }
+    layers_.clear();
     if (font_) {
         TTF_CloseFont(font_);
         font_ = nullptr;
     }
 
-    for (auto& [name, texture] : textures_) {
-        if (texture) SDL_DestroyTexture(texture);
-    }
-    textures_.clear();
-
     if (renderer_) {
         SDL_DestroyRenderer(renderer_);
         renderer_ = nullptr;
     }
 
+    if (offscreen_) {
+        SDL_FreeSurface(offscreen_);
+        offscreen_ = nullptr;
+    }
+
     if (window_) {
         SDL_DestroyWindow(window_);
         window_ = nullptr;
@@ -72,31 +104,197 @@ void Graphics::shutdown() {
     SDL_Quit();
 }
 
-bool Graphics::loadTexture(const std::string& name, const std::string& filePath) {
-    SDL_Surface* surf = IMG_Load(filePath.c_str());
-    if (!surf) {
+SDL_Surface* Graphics::decodeImage(const std::string& filePath) {
+    SDL_Surface* loaded = IMG_Load(filePath.c_str());
+    if (!loaded) {
         std::cerr << "Failed to load " << filePath << ": " << IMG_GetError() << "\n";
-        return false;
+        return nullptr;
+    }
+
+    // Atlas pages are ARGB8888, so convert once here
+    SDL_Surface* surf = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_FreeSurface(loaded);
+    if (!surf) {
+        std::cerr << "Failed to convert " << filePath << ": " << SDL_GetError() << "\n";
     }
+    return surf;
+}
+
+bool Graphics::loadTexture(const std::string& name, const std::string& filePath) {
+    SDL_Surface* surf = decodeImage(filePath);
+    if (!surf) return false;
+
+    // Don't upload more pixels than the sprite will ever show
+    size_t sourceBytes = static_cast<size_t>(surf->w) * surf->h * 4;
+    int displayW = 0, displayH = 0;
+    if (getTextureDisplaySize(name, displayW, displayH)) {
+        int sourceW = surf->w;
+        int sourceH = surf->h;
+        int level = 0;
+        surf = reduceToDisplaySize(surf, displayW, displayH, &level);
+        if (level > 0) {
+            std::cout << "Texture " << name << ": " << sourceW << "x" << sourceH << " -> mip " << level
+                      << " " << surf->w << "x" << surf->h << " for " << displayW << "x" << displayH << "\n";
+        }
+    }
+
+    addImage(name, surf, sourceBytes);
+    return true;
+}
+
+void Graphics::addImage(const std::string& name, SDL_Surface* surface, size_t sourceBytes) {
+    if (!surface) return;
+    textureMemory_.sourceBytes += sourceBytes;
+    textureMemory_.imageBytes += static_cast<size_t>(surface->w) * surface->h * 4;
+    atlas_.add(name, surface);
+}
+
+bool Graphics::getTextureDisplaySize(const std::string& name, int& width, int& height) const {
+    auto size = displaySizes_.find(name);
+    if (size == displaySizes_.end()) return false;
+    width = size->second.x;
+    height = size->second.y;
+    return true;
+}
+
+void Graphics::setTextureDisplaySize(const std::string& name, int width, int height) {
+    displaySizes_[name] = {std::max(width, 1), std::max(height, 1)};
+}
 
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer_, surf);
-    SDL_FreeSurface(surf);
+bool Graphics::loadTextureManifest(const std::string& path) {
+    std::vector<TextureDisplaySize> sizes;
+    if (!parseTextureManifest(path, sizes)) return false;
+    for (const TextureDisplaySize& size : sizes) {
+        setTextureDisplaySize(size.name, size.width, size.height);
+    }
+    return true;
+}
 
-    if (!texture) {
-        std::cerr << "Failed to create texture from " << filePath << ": " << SDL_GetError() << "\n";
+bool Graphics::parseTextureManifest(const std::string& path, std::vector<TextureDisplaySize>& sizes) {
+    tinyxml2::XMLDocument doc;
+    if (doc.LoadFile(path.c_str()) != tinyxml2::XML_SUCCESS) {
+        std::cerr << "Failed to load texture manifest: " << path << "\n";
         return false;
     }
+    auto* root = doc.RootElement();
+    if (!root) return false;
+    
+    for (auto* texture = root->FirstChildElement("Texture"); texture; texture = texture->NextSiblingElement("Texture")) {
+        const char* name = texture->Attribute("name");
+        int width = 0, height = 0;
+        if (!name || texture->QueryIntAttribute("displayWidth", &width) != tinyxml2::XML_SUCCESS ||
+            texture->QueryIntAttribute("displayHeight", &height) != tinyxml2::XML_SUCCESS) {
+            continue;
+        }
+        sizes.push_back({name, width, height});
+    }
+    return true;
+}
+
+int Graphics::loadTextureFolder(const std::string& directory) {
+    std::error_code error;
+    int loaded = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".png") continue;
+        if (loadTexture(entry.path().stem().string(), entry.path().string())) {
+            loaded++;
+        }
+    }
+    if (error) {
+        std::cerr << "Failed to read " << directory << ": " << error.message() << "\n";
+    }
+    return loaded;
+}
+
+bool Graphics::buildAtlas() {
+    // Stay within what the renderer can hold in one texture
+    int maxPageSize = 2048;
+    SDL_RendererInfo info;
+    if (SDL_GetRendererInfo(renderer_, &info) == 0 && info.max_texture_width > 0) {
+        maxPageSize = std::min({maxPageSize, info.max_texture_width, info.max_texture_height});
+    }
+    bool ok = atlas_.build(renderer_, maxPageSize);
+    std::cout << "Texture atlas: " << atlas_.getRegionCount() << " images in "
+              << atlas_.getPageCount() << " page(s), " << atlas_.getPageBytes() / 1024 << " KB\n";
+    std::cout << "Texture memory: " << textureMemory_.sourceBytes / 1024 << " KB at source size, "
+              << textureMemory_.imageBytes / 1024 << " KB after mip reduction\n";
+    return ok;
+}
 
-    // Enable alpha blending for transparency
-    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+bool Graphics::loadAtlas(const AssetArchive& archive) {
+    using Format = AssetArchiveFormat;
 
-    textures_[name] = texture;
+    // Validate every page before uploading any, so a bad archive leaves no
+    // textures behind for the loose-file fallback to build on top of
+    struct Page {
+        const AssetArchive::Entry* entry;
+        Format::AtlasPageHeader header;
+    };
+    std::vector<Page> pages;
+    for (const AssetArchive::Entry& entry : archive.getEntries()) {
+        if (entry.type != Format::EntryType::AtlasPage) continue;
+
+        Format::AtlasPageHeader page;
+        bool valid = entry.size >= sizeof(page);
+        if (valid) {
+            std::memcpy(&page, entry.data, sizeof(page));
+            valid = page.format == SDL_PIXELFORMAT_ARGB8888 && page.pitch >= page.width * 4 &&
+                    page.regionCount <= (entry.size - sizeof(page)) / sizeof(Format::AtlasRegion) &&
+                    page.pixelOffset <= entry.size &&
+                    static_cast<uint64_t>(page.pitch) * page.height <= entry.size - page.pixelOffset;
+        }
+        if (!valid) {
+            std::cerr << "Graphics: bad atlas page " << entry.name << " in asset archive\n";
+            return false;
+        }
+        pages.push_back({&entry, page});
+    }
+    if (pages.empty()) return false;
+
+    std::vector<TextureAtlas::PackedRegion> regions;
+    for (const Page& page : pages) {
+        const Format::AtlasPageHeader& header = page.header;
+        const uint8_t* data = page.entry->data;
+        regions.clear();
+        for (uint32_t i = 0; i < header.regionCount; i++) {
+            Format::AtlasRegion region;
+            std::memcpy(&region, data + sizeof(header) + i * sizeof(region), sizeof(region));
+            region.name[Format::NAME_SIZE - 1] = '\0';
+            regions.push_back({region.name, {region.x, region.y, region.w, region.h}});
+            textureMemory_.sourceBytes += region.sourceBytes;
+            textureMemory_.imageBytes += static_cast<size_t>(region.w) * region.h * 4;
+        }
+        if (!atlas_.addPage(renderer_, data + header.pixelOffset, static_cast<int>(header.width),
+                            static_cast<int>(header.height), static_cast<int>(header.pitch), regions)) {
+            std::cerr << "Graphics: atlas page " << page.entry->name
+                      << " failed to upload, dropping the archive's textures\n";
+            clearTextures();
+            return false;
+        }
+    }
+    std::cout << "Texture atlas: " << atlas_.getRegionCount() << " images in "
+              << atlas_.getPageCount() << " page(s), " << atlas_.getPageBytes() / 1024 << " KB (pre-packed)\n";
     return true;
 }
 
-SDL_Texture* Graphics::getTexture(const std::string& name) {
-    auto it = textures_.find(name);
-    return (it != textures_.end()) ? it->second : nullptr;
+void Graphics::clearTextures() {
+    atlas_.destroy();
+    textureMemory_ = {};
+}
+
+std::string Graphics::findSystemFont() {
+    static const char* const CANDIDATES[] = {
+        "C:\\Windows\\Fonts\\arial.ttf",
+        "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
+        "/usr/share/fonts/dejavu/DejaVuSans.ttf",
+        "/usr/share/fonts/TTF/DejaVuSans.ttf",
+        "/System/Library/Fonts/Supplemental/Arial.ttf",
+    };
+    for (const char* path : CANDIDATES) {
+        std::error_code error;
+        if (std::filesystem::exists(path, error)) return path;
+    }
+    return "";
 }
 
 bool Graphics::loadFont(const std::string& path, int size) {
@@ -105,6 +303,12 @@ bool Graphics::loadFont(const std::string& path, int size) {
         std::cerr << "Failed to load font: " << TTF_GetError() << "\n";
         return false;
     }
+    
+    // Rasterize the glyphs once; drawText only lays out quads from here on
+    if (!glyphAtlas_.build(renderer_, font_)) {
+        return false;
+    }
+    pendingUploads_++;
     return true;
 }
 
@@ -113,39 +317,136 @@ void Graphics::clear(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
     SDL_RenderClear(renderer_);
 }
 
+bool Graphics::setVSync(bool enabled) {
+    if (!renderer_) return false;
+    if (headless_) return !enabled;  // Nothing to sync to
+    if (SDL_RenderSetVSync(renderer_, enabled ? 1 : 0) != 0) {
+        std::cerr << "SDL_RenderSetVSync error: " << SDL_GetError() << "\n";
+        return false;
+    }
+    return true;
+}
+
+void Graphics::flush() {
+    flushBatches();
+}
+
+bool Graphics::saveScreenshot(const std::string& path) {
+    if (!renderer_) return false;
+    flushBatches();  // Include everything queued so far
+    
+    int width = 0, height = 0;
+    if (SDL_GetRendererOutputSize(renderer_, &width, &height) != 0) {
+        std::cerr << "Screenshot: " << SDL_GetError() << "\n";
+        return false;
+    }
+    SDL_Surface* shot = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!shot) {
+        std::cerr << "Screenshot: " << SDL_GetError() << "\n";
+        return false;
+    }
+    bool ok = SDL_RenderReadPixels(renderer_, nullptr, SDL_PIXELFORMAT_ARGB8888, shot->pixels, shot->pitch) == 0;
+    if (!ok) {
+        std::cerr << "Screenshot read failed: " << SDL_GetError() << "\n";
+    } else if (IMG_SavePNG(shot, path.c_str()) != 0) {
+        std::cerr << "Failed to write " << path << ": " << IMG_GetError() << "\n";
+        ok = false;
+    }
+    SDL_FreeSurface(shot);
+    return ok;
+}
+
+int Graphics::getDisplayRefreshRate() const {
+    if (!window_) return 0;
+    SDL_DisplayMode mode;
+    if (SDL_GetWindowDisplayMode(window_, &mode) != 0) return 0;
+    return mode.refresh_rate;
+}
+
 void Graphics::present() {
+    flushBatches();
     SDL_RenderPresent(renderer_);
+    
+    primitiveStats_.frameShapes = pendingShapes_;
+    primitiveStats_.frameDrawCalls = pendingShapeDrawCalls_;
+    primitiveStats_.maxShapes = std::max(primitiveStats_.maxShapes, pendingShapes_);
+    pendingShapes_ = 0;
+    pendingShapeDrawCalls_ = 0;
+    
+    spriteStats_.frameSprites = pendingSprites_;
+    spriteStats_.frameDrawCalls = pendingSpriteDrawCalls_;
+    spriteStats_.maxDrawCalls = std::max(spriteStats_.maxDrawCalls, pendingSpriteDrawCalls_);
+    pendingSprites_ = 0;
+    pendingSpriteDrawCalls_ = 0;
+    
+    layerStats_.frames++;
+    layerStats_.redraws += pendingLayerRedraws_;
+    if (pendingLayerRedraws_ > 0) layerStats_.framesWithRedraws++;
+    pendingLayerRedraws_ = 0;
+    
+    textStats_.frames++;
+    textStats_.textureUploads += pendingUploads_;
+    if (pendingUploads_ > 0) textStats_.framesWithUploads++;
+    textStats_.frameUploads = pendingUploads_;
+    textStats_.frameDrawCalls = pendingDrawCalls_;
+    textStats_.frameGlyphs = pendingGlyphs_;
+    pendingUploads_ = 0;
+    pendingDrawCalls_ = 0;
+    pendingGlyphs_ = 0;
 }
 
 void Graphics::drawTexture(SDL_Texture* texture, int x, int y, int w, int h) {
+    flushBatches();  // Keep draw order with queued sprites and text
     if (!texture) return;
     SDL_Rect destRect = {x, y, w, h};
     SDL_RenderCopy(renderer_, texture, nullptr, &destRect);
 }
 
+void Graphics::drawSprite(TextureHandle texture, float x, float y, float w, float h,
+                          float rotation, int layer) {
+    spriteBatch_.add(atlas_.getRegion(texture), {x, y, w, h}, rotation, layer);
+}
+
+void Graphics::flushSprites() {
+    pendingSprites_ += static_cast<int>(spriteBatch_.size());
+    pendingSpriteDrawCalls_ += spriteBatch_.flush(renderer_);
+}
+
+// Primitives first: shapes queued alongside sprites were queued before them
+// (see getPrimitiveBatch), and text is always drawn on top of the sprites
+void Graphics::flushBatches() {
+    flushPrimitives();
+    flushSprites();
+    flushText();
+}
+
+PrimitiveBatch& Graphics::getPrimitiveBatch() {
+    // Keep draw order: sprites and text queued earlier go underneath
+    if (!spriteBatch_.empty() || glyphAtlas_.getPendingGlyphs() > 0) {
+        flushBatches();
+    }
+    return primitiveBatch_;
+}
+
+void Graphics::flushPrimitives() {
+    pendingShapes_ += static_cast<int>(primitiveBatch_.getShapeCount());
+    pendingShapeDrawCalls_ += primitiveBatch_.flush(renderer_);
+}
+
 void Graphics::drawRect(int x, int y, int w, int h, Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
-    SDL_SetRenderDrawColor(renderer_, r, g, b, a);
-    SDL_Rect rect = {x, y, w, h};
-    SDL_RenderDrawRect(renderer_, &rect);
+    SDL_FRect rect = {static_cast<float>(x), static_cast<float>(y), static_cast<float>(w), static_cast<float>(h)};
+    getPrimitiveBatch().addRect(rect, {r, g, b, a});
 }
 
 void Graphics::drawFilledRect(int x, int y, int w, int h, Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
-    SDL_SetRenderDrawColor(renderer_, r, g, b, a);
-    SDL_Rect rect = {x, y, w, h};
-    SDL_RenderFillRect(renderer_, &rect);
+    SDL_FRect rect = {static_cast<float>(x), static_cast<float>(y), static_cast<float>(w), static_cast<float>(h)};
+    getPrimitiveBatch().addFilledRect(rect, {r, g, b, a});
 }
 
 void Graphics::drawFilledCircle(int centerX, int centerY, int radius, Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
-    SDL_SetRenderDrawColor(renderer_, r, g, b, a);
-    
-    // Draw filled circle using midpoint circle algorithm
-    for (int y = -radius; y <= radius; y++) {
-        for (int x = -radius; x <= radius; x++) {
-            if (x*x + y*y <= radius*radius) {
-                SDL_RenderDrawPoint(renderer_, centerX + x, centerY + y);
-            }
-        }
-    }
+    // Centred on the centre pixel's midpoint, so the fan covers (to within its
+    // quarter-pixel tolerance) the pixels the old x*x + y*y <= r*r point loop drew
+    getPrimitiveBatch().addFilledCircle(centerX + 0.5f, centerY + 0.5f, static_cast<float>(radius), {r, g, b, a});
 }
 
 void Graphics::drawLine(int x1, int y1, int x2, int y2, Uint32 color) {
@@ -153,30 +454,104 @@ void Graphics::drawLine(int x1, int y1, int x2, int y2, Uint32 color) {
     Uint8 g = (color >> 8) & 0xFF;
     Uint8 b = color & 0xFF;
     Uint8 a = 255;
-    
-    SDL_SetRenderDrawColor(renderer_, r, g, b, a);
-    SDL_RenderDrawLine(renderer_, x1, y1, x2, y2);
+    getPrimitiveBatch().addLine(static_cast<float>(x1), static_cast<float>(y1),
+                                static_cast<float>(x2), static_cast<float>(y2), {r, g, b, a});
 }
 
 void Graphics::drawText(const std::string& text, int x, int y, Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
-    if (!font_) return;
+    if (!glyphAtlas_.isReady()) return;
     
-    SDL_Color color = {r, g, b, a};
-    SDL_Surface* surface = TTF_RenderText_Solid(font_, text.c_str(), color);
-    if (!surface) {
-        std::cerr << "Failed to render text: " << TTF_GetError() << "\n";
-        return;
+    // No rasterization or upload here: the glyphs are already in the atlas
+    glyphAtlas_.addText(text, static_cast<float>(x), static_cast<float>(y), {r, g, b, a});
+}
+
+void Graphics::flushText() {
+    int glyphs = glyphAtlas_.getPendingGlyphs();
+    if (glyphAtlas_.flush()) {
+        pendingDrawCalls_++;
+        pendingGlyphs_ += glyphs;
     }
-    
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer_, surface);
-    if (!texture) {
-        SDL_FreeSurface(surface);
-        return;
+}
+
+int Graphics::createLayer() {
+    layers_.push_back({});
+    return static_cast<int>(layers_.size()) - 1;
+}
+
+void Graphics::markLayerDirty(int layer) {
+    if (layer >= 0 && layer < static_cast<int>(layers_.size())) {
+        layers_[layer].dirty = true;
+    }
+}
+
+void Graphics::markAllLayersDirty() {
+    for (Layer& layer : layers_) {
+        layer.dirty = true;
     }
+}
+
+bool Graphics::isLayerDirty(int layer) const {
+    if (layer < 0 || layer >= static_cast<int>(layers_.size())) return false;
+    return !layersCached_ || layers_[layer].dirty || !layers_[layer].texture;
+}
+
+bool Graphics::beginLayer(int index) {
+    if (index < 0 || index >= static_cast<int>(layers_.size()) || activeLayer_ >= 0) return false;
+    Layer& layer = layers_[index];
     
-    SDL_Rect destRect = {x, y, surface->w, surface->h};
-    SDL_RenderCopy(renderer_, texture, nullptr, &destRect);
+    if (layersCached_ && !layer.texture) {
+        layer.texture = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_ARGB8888,
+                                          SDL_TEXTUREACCESS_TARGET, width_, height_);
+        if (!layer.texture) {
+            std::cerr << "Failed to create layer texture: " << SDL_GetError() << "\n";
+            return false;
+        }
+        // Drawing onto a transparent target leaves premultiplied colour, so
+        // composite it as premultiplied to keep antialiased edges from darkening
+        if (SDL_SetTextureBlendMode(layer.texture, SDL_ComposeCustomBlendMode(
+                SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+                SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD)) != 0) {
+            // e.g. the software renderer (headless mode). Plain BLEND would
+            // darken edges twice, so skip the cache and draw straight to the
+            // screen every frame instead; same output, just not cached.
+            std::cerr << "Cached layers disabled, renderer has no premultiplied blending: "
+                      << SDL_GetError() << "\n";
+            for (Layer& other : layers_) {
+                if (other.texture) SDL_DestroyTexture(other.texture);
+                other.texture = nullptr;
+            }
+            layersCached_ = false;
+        }
+    }
     
-    SDL_DestroyTexture(texture);
-    SDL_FreeSurface(surface);
+    flushBatches();  // Anything queued belongs to the screen, not the layer
+    if (!layersCached_) {
+        activeLayer_ = index;  // Draws go straight to the screen, in order
+        return true;
+    }
+    if (SDL_SetRenderTarget(renderer_, layer.texture) != 0) {
+        std::cerr << "Failed to bind layer: " << SDL_GetError() << "\n";
+        return false;
+    }
+    SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 0);
+    SDL_RenderClear(renderer_);
+    activeLayer_ = index;
+    return true;
+}
+
+void Graphics::endLayer() {
+    if (activeLayer_ < 0) return;
+    flushBatches();
+    if (layersCached_) {
+        SDL_SetRenderTarget(renderer_, nullptr);
+    }
+    layers_[activeLayer_].dirty = false;
+    activeLayer_ = -1;
+    pendingLayerRedraws_++;
+}
+
+void Graphics::drawLayer(int index) {
+    if (index < 0 || index >= static_cast<int>(layers_.size()) || !layers_[index].texture) return;
+    flushBatches();  // Keep draw order with queued sprites and text
+    SDL_RenderCopy(renderer_, layers_[index].texture, nullptr, nullptr);
 }
@@ -4,6 +4,12 @@
 #include <SDL_ttf.h>
 #include <string>
 #include <unordered_map>
+#include <vector>
+#include "AssetArchive.h"
+#include "GlyphAtlas.h"
+#include "PrimitiveBatch.h"
+#include "SpriteBatch.h"
+#include "TextureAtlas.h"
 #include "View.h"
 
 class Graphics {
@@ -11,28 +17,143 @@ public:
     Graphics() = default;
     ~Graphics();
 
-    bool init(const std::string& title, int width, int height);
+    // Headless: SDL's dummy video driver and a software renderer drawing into
+    // an offscreen surface (no window, no vsync), for benchmarks and CI
+    bool init(const std::string& title, int width, int height, bool headless = false);
     void shutdown();
+    bool isHeadless() const { return headless_; }
 
-    // Texture management
+    // Read back what the renderer currently shows and write it as a PNG
+    // (call before present(); works windowed and headless)
+    bool saveScreenshot(const std::string& path);
+
+    // Texture management: images are queued by loadTexture/loadTextureFolder
+    // and packed into atlas pages by buildAtlas(). Look each name up once with
+    // findTexture() and keep the handle; its region exists after buildAtlas().
     bool loadTexture(const std::string& name, const std::string& filePath);
-    SDL_Texture* getTexture(const std::string& name);
+    int loadTextureFolder(const std::string& directory);  // Every PNG, named by file stem
+    bool buildAtlas();
+    TextureHandle findTexture(const std::string& name) const { return atlas_.find(name); }
+    const TextureRegion& getRegion(TextureHandle texture) const { return atlas_.getRegion(texture); }
+    const TextureAtlas& getTextures() const { return atlas_; }
+
+    // Largest size a texture is drawn at. Set before loading; oversized images
+    // are reduced on the CPU to the smallest mip level that still covers it.
+    void setTextureDisplaySize(const std::string& name, int width, int height);
+    bool getTextureDisplaySize(const std::string& name, int& width, int& height) const;
+    bool loadTextureManifest(const std::string& path);
+    struct TextureDisplaySize {
+        std::string name;
+        int width, height;
+    };
+    static bool parseTextureManifest(const std::string& path, std::vector<TextureDisplaySize>& sizes);
+
+    // Loading in pieces (see AssetLoader): decodeImage() is thread-safe and
+    // returns an ARGB8888 surface; addImage() queues a decoded (and possibly
+    // reduced) image for the next buildAtlas() and takes ownership of it
+    static SDL_Surface* decodeImage(const std::string& filePath);
+    void addImage(const std::string& name, SDL_Surface* surface, size_t sourceBytes);
+
+    // Pre-packed atlas pages from an asset archive, uploaded straight from the
+    // mapped pixels: replaces loadTexture*/buildAtlas when assets.pak exists.
+    // All or nothing: on failure no page of the archive stays loaded.
+    bool loadAtlas(const AssetArchive& archive);
+    void clearTextures();  // Drop every atlas page and image (invalidates handles)
+
+    // Texture memory (32-bit pixels): as loaded from disk vs. what was uploaded
+    struct TextureMemoryStats {
+        size_t sourceBytes = 0;
+        size_t imageBytes = 0;  // After mip reduction
+    };
+    const TextureMemoryStats& getTextureMemoryStats() const { return textureMemory_; }
 
     // Font management
     bool loadFont(const std::string& path, int size);
+    static std::string findSystemFont();  // First common system font present, or ""
 
     // Drawing operations
     void clear(Uint8 r, Uint8 g, Uint8 b, Uint8 a);
     void present();
+    void flush();  // Draw everything queued (sprites, primitives, text) without presenting
     void drawTexture(SDL_Texture* texture, int x, int y, int w, int h);
+
+    // Sprites are queued into the sprite batch and drawn, sorted by layer and
+    // texture, at the next non-batched draw through Graphics or at present()
+    static constexpr int WORLD_LAYER = 0;
+    static constexpr int HUD_LAYER = 100;
+    void drawSprite(TextureHandle texture, float x, float y, float w, float h,
+                    float rotation = 0.0f, int layer = WORLD_LAYER);
+    SpriteBatch& getSpriteBatch() { return spriteBatch_; }
+    void flushSprites();
+    // Rects, circles and lines are queued into the primitive batch, drawn in
+    // submission order with one call at the next flush. Queued sprites and
+    // text are flushed first, so anything drawn after them stays on top.
     void drawRect(int x, int y, int w, int h, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
     void drawFilledRect(int x, int y, int w, int h, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
     void drawFilledCircle(int centerX, int centerY, int radius, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
     void drawLine(int x1, int y1, int x2, int y2, Uint32 color);
+    PrimitiveBatch& getPrimitiveBatch();  // Direct access; same ordering rules
+    void flushPrimitives();
+    // Text is queued into the glyph atlas batch and drawn in one call at the
+    // next non-text draw through Graphics or at present()
     void drawText(const std::string& text, int x, int y, Uint8 r = 255, Uint8 g = 255, Uint8 b = 255, Uint8 a = 255);
+    void flushText();
+
+    // Cached layers: screen-sized render targets for static or rarely changing
+    // content. Draw into a layer between beginLayer/endLayer only when it is
+    // dirty, then composite it every frame with drawLayer (one copy). On
+    // renderers without custom blend modes (software) layers are never
+    // cached: they always report dirty and beginLayer draws to the screen.
+    int createLayer();
+    void markLayerDirty(int layer);
+    void markAllLayersDirty();  // e.g. after the renderer lost its render targets
+    bool isLayerDirty(int layer) const;
+    bool beginLayer(int layer);  // Redirects drawing into the layer and clears it
+    void endLayer();
+    void drawLayer(int layer);
+
+    // Text rendering statistics
+    struct TextStats {
+        long long textureUploads = 0;     // Total glyph texture uploads (atlas builds)
+        long long framesWithUploads = 0;  // Frames that uploaded any glyph texture
+        long long frames = 0;
+        int frameUploads = 0;             // Last presented frame
+        int frameDrawCalls = 0;
+        int frameGlyphs = 0;
+    };
+    const TextStats& getTextStats() const { return textStats_; }
+
+    // Sprite batching statistics
+    struct SpriteStats {
+        int frameSprites = 0;    // Last presented frame
+        int frameDrawCalls = 0;
+        int maxDrawCalls = 0;    // Worst frame so far
+    };
+    const SpriteStats& getSpriteStats() const { return spriteStats_; }
+
+    // Primitive batching statistics
+    struct PrimitiveStats {
+        int frameShapes = 0;     // Last presented frame
+        int frameDrawCalls = 0;
+        int maxShapes = 0;       // Busiest frame so far
+    };
+    const PrimitiveStats& getPrimitiveStats() const { return primitiveStats_; }
+
+    // Cached layer statistics
+    struct LayerStats {
+        long long redraws = 0;            // Times any layer was re-rendered
+        long long framesWithRedraws = 0;
+        long long frames = 0;
+    };
+    const LayerStats& getLayerStats() const { return layerStats_; }
 
     // Getters (for components that still need raw SDL access)
     SDL_Renderer* getRenderer() { return renderer_; }
+    
+    // Frame pacing support: toggle present() blocking on vsync, and the
+    // refresh rate of the display the window is on (0 if unknown)
+    bool setVSync(bool enabled);
+    int getDisplayRefreshRate() const;
     SDL_Window* getWindow() { return window_; }
     
     // Static view access for engine-level rendering
@@ -43,6 +164,37 @@ private:
     static View* view_;
     SDL_Window* window_ = nullptr;
     SDL_Renderer* renderer_ = nullptr;
+    SDL_Surface* offscreen_ = nullptr;  // Headless render target
+    bool headless_ = false;
     TTF_Font* font_ = nullptr;
-    std::unordered_map<std::string, SDL_Texture*> textures_;
+    GlyphAtlas glyphAtlas_;
+    TextStats textStats_;
+    int pendingUploads_ = 0;
+    int pendingDrawCalls_ = 0;
+    int pendingGlyphs_ = 0;
+    TextureAtlas atlas_;
+    std::unordered_map<std::string, SDL_Point> displaySizes_;
+    TextureMemoryStats textureMemory_;
+    SpriteBatch spriteBatch_;
+    SpriteStats spriteStats_;
+    int pendingSprites_ = 0;
+    int pendingSpriteDrawCalls_ = 0;
+    PrimitiveBatch primitiveBatch_;
+    PrimitiveStats primitiveStats_;
+    int pendingShapes_ = 0;
+    int pendingShapeDrawCalls_ = 0;
+
+    void flushBatches();
+
+    struct Layer {
+        SDL_Texture* texture = nullptr;
+        bool dirty = true;
+    };
+    std::vector<Layer> layers_;
+    int activeLayer_ = -1;
+    bool layersCached_ = true;  // False if the renderer cannot composite premultiplied layers
+    int width_ = 0;
+    int height_ = 0;
+    LayerStats layerStats_;
+    int pendingLayerRedraws_ = 0;
 };
@@ -1,4 +1,5 @@
 #include "Input.h"
+#include <algorithm>
 #include <cstring>
 
 void Input::update() {
@@ -19,18 +20,128 @@ void Input::update() {
 
 bool Input::processEvents() {
     quitRequested_ = false;
+    renderTargetsReset_ = false;
     
     SDL_Event e;
     while (SDL_PollEvent(&e)) {
-        if (e.type == SDL_QUIT) {
-            quitRequested_ = true;
-            return false;
+        switch (e.type) {
+            case SDL_QUIT:
+                quitRequested_ = true;
+                return false;
+            case SDL_RENDER_TARGETS_RESET:
+            case SDL_RENDER_DEVICE_RESET:
+                renderTargetsReset_ = true;
+                break;
+            case SDL_KEYDOWN:
+            case SDL_KEYUP: {
+                Key key = scancodeToKey(e.key.keysym.scancode);
+                if (e.key.repeat || key == Key::UNKNOWN) break;
+                InputEvent event = {};
+                event.type = e.type == SDL_KEYDOWN ? InputEvent::Type::KeyDown : InputEvent::Type::KeyUp;
+                event.key = key;
+                event.button = MouseButton::UNKNOWN;
+                event.timestamp = e.key.timestamp;
+                queueEvent(event);
+                break;
+            }
+            case SDL_MOUSEBUTTONDOWN:
+            case SDL_MOUSEBUTTONUP: {
+                MouseButton button = mouseButtonFromSDL(e.button.button);
+                if (button == MouseButton::UNKNOWN) break;
+                InputEvent event = {};
+                event.type = e.type == SDL_MOUSEBUTTONDOWN ? InputEvent::Type::MouseDown : InputEvent::Type::MouseUp;
+                event.key = Key::UNKNOWN;
+                event.button = button;
+                event.x = e.button.x;
+                event.y = e.button.y;
+                event.timestamp = e.button.timestamp;
+                queueEvent(event);
+                break;
+            }
+            default:
+                break;
         }
     }
     
     return true;
 }
 
+void Input::queueEvent(InputEvent event) {
+    event.queuedAt = SDL_GetPerformanceCounter();
+    if (event.type == InputEvent::Type::KeyDown) {
+        eventKeysDown_ |= KeySnapshot::bit(event.key);
+    } else if (event.type == InputEvent::Type::KeyUp) {
+        eventKeysDown_ &= ~KeySnapshot::bit(event.key);
+    }
+
+    uint32_t head = eventHead_.load(std::memory_order_relaxed);
+    if (head - eventTail_.load(std::memory_order_acquire) == EVENT_CAPACITY) {
+        // Keep what is queued; the simulation sees it in order, then takes
+        // the key state as of this drop
+        droppedEvents_++;
+        keyResync_.store((static_cast<uint64_t>(head) << 32) | RESYNC_PENDING | eventKeysDown_,
+                         std::memory_order_release);
+        return;
+    }
+    events_[head % EVENT_CAPACITY] = event;
+    eventHead_.store(head + 1, std::memory_order_release);
+}
+
+KeySnapshot Input::takeKeys() {
+    // Resync record first: the head loaded after it is at or past its position
+    uint64_t resync = keyResync_.exchange(0, std::memory_order_acquire);
+    uint32_t resyncAt = static_cast<uint32_t>(resync >> 32);
+
+    tickEvents_.clear();
+    uint32_t tail = eventTail_.load(std::memory_order_relaxed);
+    uint32_t head = eventHead_.load(std::memory_order_acquire);
+    size_t resyncEvent = SIZE_MAX;  // Replay index the resync applies before
+    for (; tail != head; tail++) {
+        if (resync && tail == resyncAt) resyncEvent = tickEvents_.size();
+        tickEvents_.push_back(events_[tail % EVENT_CAPACITY]);
+    }
+    eventTail_.store(tail, std::memory_order_release);
+    if (resync && resyncEvent == SIZE_MAX) resyncEvent = tickEvents_.size();
+
+    // Replay the edges in order, so taps shorter than a tick are not lost
+    KeySnapshot keys;
+    uint64_t now = SDL_GetPerformanceCounter();
+    double msPerCount = 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+    for (size_t i = 0; i <= tickEvents_.size(); i++) {
+        if (i == resyncEvent) {
+            // Events were dropped here: jump to the event thread's key state
+            uint32_t down = static_cast<uint32_t>(resync) & ~static_cast<uint32_t>(RESYNC_PENDING);
+            keys.pressed |= down & ~keysDown_;
+            keys.released |= keysDown_ & ~down;
+            keysDown_ = down;
+        }
+        if (i == tickEvents_.size()) break;
+        const InputEvent& event = tickEvents_[i];
+        double latencyMs = static_cast<double>(now - event.queuedAt) * msPerCount;
+        latency_.events++;
+        latency_.totalMs += latencyMs;
+        latency_.maxMs = std::max(latency_.maxMs, latencyMs);
+
+        if (!event.isKey()) continue;
+        uint32_t bit = KeySnapshot::bit(event.key);
+        if (event.type == InputEvent::Type::KeyDown) {
+            keys.pressed |= bit;
+            keysDown_ |= bit;
+        } else {
+            keys.released |= bit;
+            keysDown_ &= ~bit;
+        }
+    }
+    keys.down = keysDown_;
+    return keys;
+}
+
+Input::LatencyStats Input::getLatencyStats() const {
+    LatencyStats stats = latency_;
+    stats.dropped = droppedEvents_;
+    return stats;
+}
+
 bool Input::isKeyDown(Key key) const {
     if (!keyboardState_) return false;
     SDL_Scancode scancode = keyToScancode(key);
@@ -89,6 +200,26 @@ SDL_Scancode Input::keyToScancode(Key key) const {
     }
 }
 
+Key Input::scancodeToKey(SDL_Scancode scancode) {
+    switch (scancode) {
+        case SDL_SCANCODE_LEFT:   return Key::LEFT;
+        case SDL_SCANCODE_RIGHT:  return Key::RIGHT;
+        case SDL_SCANCODE_UP:     return Key::UP;
+        case SDL_SCANCODE_DOWN:   return Key::DOWN;
+        case SDL_SCANCODE_A:      return Key::A;
+        case SDL_SCANCODE_D:      return Key::D;
+        case SDL_SCANCODE_W:      return Key::W;
+        case SDL_SCANCODE_S:      return Key::S;
+        case SDL_SCANCODE_R:      return Key::R;
+        case SDL_SCANCODE_F:      return Key::F;
+        case SDL_SCANCODE_T:      return Key::T;
+        case SDL_SCANCODE_SPACE:  return Key::SPACE;
+        case SDL_SCANCODE_RETURN: return Key::ENTER;
+        case SDL_SCANCODE_ESCAPE: return Key::ESCAPE;
+        default:                  return Key::UNKNOWN;
+    }
+}
+
 Uint8 Input::mouseButtonToSDL(MouseButton button) const {
     switch (button) {
         case MouseButton::LEFT:   return SDL_BUTTON_LEFT;
@@ -97,3 +228,12 @@ Uint8 Input::mouseButtonToSDL(MouseButton button) const {
         default:                  return 0;
     }
 }
+
+MouseButton Input::mouseButtonFromSDL(Uint8 button) {
+    switch (button) {
+        case SDL_BUTTON_LEFT:   return MouseButton::LEFT;
+        case SDL_BUTTON_RIGHT:  return MouseButton::RIGHT;
+        case SDL_BUTTON_MIDDLE: return MouseButton::MIDDLE;
+        default:                return MouseButton::UNKNOWN;
+    }
+}
@@ -1,8 +1,12 @@
 #pragma once
 
 #include <SDL.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <unordered_map>
 #include <string>
+#include <vector>
 
 enum class Key {
     LEFT, RIGHT, UP, DOWN,
@@ -19,14 +23,43 @@ enum class MouseButton {
     UNKNOWN
 };
 
+// A key or mouse button edge as SDL reported it (key repeats are dropped)
+struct InputEvent {
+    enum class Type : uint8_t { KeyDown, KeyUp, MouseDown, MouseUp };
+    Type type;
+    Key key;                // Key events
+    MouseButton button;     // Mouse events
+    int x, y;               // Mouse events: window coordinates
+    uint32_t timestamp;     // SDL event time (ms, SDL_GetTicks clock)
+    uint64_t queuedAt;      // When processEvents() queued it (SDL_GetPerformanceCounter)
+
+    bool isKey() const { return type == Type::KeyDown || type == Type::KeyUp; }
+};
+
+static_assert(static_cast<int>(Key::UNKNOWN) < 31, "key bits must fit below Input::RESYNC_PENDING");
+
+// Keyboard state for one simulation tick, built from the events it received
+struct KeySnapshot {
+    uint32_t down = 0;      // Bit per Key, after this tick's events
+    uint32_t pressed = 0;   // Went down during the tick (even if released again)
+    uint32_t released = 0;  // Went up during the tick
+
+    bool isDown(Key key) const { return (down & bit(key)) != 0; }
+    bool isPressed(Key key) const { return (pressed & bit(key)) != 0; }
+    bool isReleased(Key key) const { return (released & bit(key)) != 0; }
+    bool isHeld(Key key) const { return ((down | pressed) & bit(key)) != 0; }  // Down at any point in the tick
+    static uint32_t bit(Key key) { return 1u << static_cast<int>(key); }
+};
+
 class Input {
 public:
     Input() = default;
 
-    // Call this each frame to update input state
+    // Call this each frame, after processEvents(), to update input state
     void update();
     
-    // Process SDL events (returns false if quit event received)
+    // Process SDL events (returns false if quit event received). Key and
+    // mouse button events are queued with their timestamps for the simulation.
     bool processEvents();
 
     // Keyboard queries
@@ -43,9 +76,38 @@ public:
     // Quit
     bool quitRequested() const { return quitRequested_; }
 
+    // The renderer lost its render-target contents since the last processEvents()
+    bool renderTargetsReset() const { return renderTargetsReset_; }
+
+    // Cross-thread hand-over. processEvents() (event thread) queues every
+    // key and mouse button edge; the simulation calls takeKeys() once per
+    // tick, which delivers the events queued since the previous tick, in
+    // order, and returns the key state they leave behind. A press and release
+    // between two ticks still shows up as pressed (and released) in one tick.
+    // If the queue overflows, the key state is resynchronised from the event
+    // thread's own, so a dropped release never leaves a key held.
+    KeySnapshot takeKeys();
+    const std::vector<InputEvent>& getTickEvents() const { return tickEvents_; }  // From the last takeKeys()
+
+    // Input-to-simulation latency: from when processEvents() queued the event
+    // to the tick that took it, on the performance counter (SDL's millisecond
+    // event timestamps are too coarse for a sub-frame delay). Read once the
+    // simulation thread has stopped.
+    struct LatencyStats {
+        long long events = 0;
+        long long dropped = 0;  // Queue full (simulation stalled)
+        double totalMs = 0.0;
+        double maxMs = 0.0;
+        double meanMs() const { return events > 0 ? totalMs / events : 0.0; }
+    };
+    LatencyStats getLatencyStats() const;
+
 private:
     SDL_Scancode keyToScancode(Key key) const;
     Uint8 mouseButtonToSDL(MouseButton button) const;
+    static Key scancodeToKey(SDL_Scancode scancode);
+    static MouseButton mouseButtonFromSDL(Uint8 button);
+    void queueEvent(InputEvent event);
 
     const Uint8* keyboardState_ = nullptr;
     Uint8 prevKeyboardState_[SDL_NUM_SCANCODES] = {};
@@ -56,4 +118,25 @@ private:
     int mouseY_ = 0;
     
     bool quitRequested_ = false;
+    bool renderTargetsReset_ = false;
+
+    // Single-producer/single-consumer ring: the event thread writes at
+    // head, the simulation reads from tail
+    static constexpr uint32_t EVENT_CAPACITY = 256;  // Power of two
+    std::array<InputEvent, EVENT_CAPACITY> events_;
+    std::atomic<uint32_t> eventHead_{0};
+    std::atomic<uint32_t> eventTail_{0};
+    long long droppedEvents_ = 0;  // Event thread
+    uint32_t eventKeysDown_ = 0;   // Event thread: after every key event, queued or not
+
+    // Set by the event thread when it drops an event: its key state and the
+    // ring position it is valid at (events before it are older). Position
+    // in the high half; RESYNC_PENDING marks a record as present.
+    static constexpr uint64_t RESYNC_PENDING = 1ull << 31;
+    std::atomic<uint64_t> keyResync_{0};
+
+    // Simulation thread
+    uint32_t keysDown_ = 0;
+    std::vector<InputEvent> tickEvents_;
+    LatencyStats latency_;
 };
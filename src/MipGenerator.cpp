@@ -0,0 +1,65 @@
+#include "MipGenerator.h"
+#include <algorithm>
+#include <cstdint>
+
+SDL_Surface* generateHalfMip(SDL_Surface* source) {
+    if (!source || source->format->format != SDL_PIXELFORMAT_ARGB8888) return nullptr;
+
+    int srcW = source->w;
+    int srcH = source->h;
+    int dstW = std::max(1, srcW / 2);
+    int dstH = std::max(1, srcH / 2);
+    SDL_Surface* dest = SDL_CreateRGBSurfaceWithFormat(0, dstW, dstH, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!dest) return nullptr;
+
+    if (SDL_MUSTLOCK(source)) SDL_LockSurface(source);
+    const uint8_t* srcPixels = static_cast<const uint8_t*>(source->pixels);
+    uint8_t* dstPixels = static_cast<uint8_t*>(dest->pixels);
+
+    for (int y = 0; y < dstH; y++) {
+        const uint32_t* row0 = reinterpret_cast<const uint32_t*>(srcPixels + std::min(2 * y, srcH - 1) * source->pitch);
+        const uint32_t* row1 = reinterpret_cast<const uint32_t*>(srcPixels + std::min(2 * y + 1, srcH - 1) * source->pitch);
+        uint32_t* out = reinterpret_cast<uint32_t*>(dstPixels + y * dest->pitch);
+
+        for (int x = 0; x < dstW; x++) {
+            int x0 = std::min(2 * x, srcW - 1);
+            int x1 = std::min(2 * x + 1, srcW - 1);
+            const uint32_t texels[4] = {row0[x0], row0[x1], row1[x0], row1[x1]};
+
+            // Colour weighted by alpha, alpha averaged
+            uint32_t a = 0, r = 0, g = 0, b = 0;
+            for (uint32_t texel : texels) {
+                uint32_t ta = texel >> 24;
+                a += ta;
+                r += ((texel >> 16) & 0xFF) * ta;
+                g += ((texel >> 8) & 0xFF) * ta;
+                b += (texel & 0xFF) * ta;
+            }
+            if (a == 0) {
+                out[x] = 0;
+                continue;
+            }
+            uint32_t outA = (a + 2) / 4;
+            uint32_t outR = (r + a / 2) / a;
+            uint32_t outG = (g + a / 2) / a;
+            uint32_t outB = (b + a / 2) / a;
+            out[x] = (outA << 24) | (outR << 16) | (outG << 8) | outB;
+        }
+    }
+
+    if (SDL_MUSTLOCK(source)) SDL_UnlockSurface(source);
+    return dest;
+}
+
+SDL_Surface* reduceToDisplaySize(SDL_Surface* source, int displayWidth, int displayHeight, int* levelOut) {
+    int level = 0;
+    while (source && source->w / 2 >= displayWidth && source->h / 2 >= displayHeight) {
+        SDL_Surface* next = generateHalfMip(source);
+        if (!next) break;
+        SDL_FreeSurface(source);
+        source = next;
+        level++;
+    }
+    if (levelOut) *levelOut = level;
+    return source;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <SDL.h>
+
+// CPU mip generation for oversized source images.
+// Both functions work on SDL_PIXELFORMAT_ARGB8888 surfaces and filter with
+// alpha weighting, so transparent pixels don't darken the edges of a sprite.
+
+// Next mip level: 2x2 box filter, half the size (odd edges are clamped).
+// Returns a new surface, or nullptr on failure.
+SDL_Surface* generateHalfMip(SDL_Surface* source);
+
+// Walk the mip chain down from `source` and return the smallest level that is
+// still at least displayWidth x displayHeight, so it is never magnified when
+// drawn at that size. Takes ownership of `source` (it may be returned as is).
+// `levelOut` receives the chosen level (0 = source).
+SDL_Surface* reduceToDisplaySize(SDL_Surface* source, int displayWidth, int displayHeight, int* levelOut = nullptr);
@@ -3,6 +3,8 @@
 #include "SpriteComponent.h"
 #include "ControllerComponent.h"
 #include "BehaviorComponent.h"
+#include "Graphics.h"
+#include "Snapshot.h"
 #include <tinyxml2.h>
 #include <iostream>
 
@@ -11,20 +13,260 @@ ObjectFactory& ObjectFactory::instance() {
     return inst;
 }
 
-void ObjectFactory::registerType(const std::string& type, CreateFunc func) {
-    creators_[type] = func;
+const char* ComponentDefinition::numberName(Number number) {
+    static const char* const NAMES[NUMBER_COUNT] = {
+        "x", "y", "width", "height", "speed", "velocityX", "velocityY", "restitution", "layer"
+    };
+    return number < NUMBER_COUNT ? NAMES[number] : "unknown";
 }
 
-std::unique_ptr<GameObject> ObjectFactory::create(const std::string& type, const ObjectParams& params) {
-    auto it = creators_.find(type);
-    if (it != creators_.end()) {
-        return it->second(params);
+void ObjectFactory::setWorld(PhysicsWorld* world, SDL_Renderer* renderer, int screenWidth, int screenHeight) {
+    world_ = world;
+    renderer_ = renderer;
+    screenWidth_ = screenWidth;
+    screenHeight_ = screenHeight;
+}
+
+int ObjectFactory::resolveTextures(const Graphics& graphics) {
+    textures_ = &graphics.getTextures();
+    int missing = 0;
+    for (ObjectPrototype& prototype : prototypes_) {
+        if (!(prototype.components & componentBit(ComponentType::Sprite))) continue;
+        prototype.sprite.texture = graphics.findTexture(prototype.sprite.textureName);
+        if (!graphics.getRegion(prototype.sprite.texture).texture) {
+            std::cerr << "Object " << prototype.type << ": no texture \"" << prototype.sprite.textureName << "\"\n";
+            missing++;
+        }
+    }
+    return missing;
+}
+
+ObjectFactory::PrototypeId ObjectFactory::findPrototype(const std::string& type) const {
+    auto it = prototypeIds_.find(type);
+    if (it == prototypeIds_.end()) {
+        std::cerr << "Unknown object type: " << type << "\n";
+        return INVALID_PROTOTYPE;
+    }
+    return it->second;
+}
+
+ObjectPrototype* ObjectFactory::getPrototype(PrototypeId id) {
+    return id < prototypes_.size() ? &prototypes_[id] : nullptr;
+}
+
+void ObjectFactory::reserve(PrototypeId id, size_t count) {
+    if (id >= prototypes_.size()) return;
+    ComponentMask mask = prototypes_[id].components;
+    auto& registry = ComponentRegistry::instance();
+    auto grow = [&](auto& pool, ComponentType type) {
+        if (mask & componentBit(type)) {
+            pool.reserve(pool.size() + count);
+        }
+    };
+    grow(registry.pool<BodyComponent>(), ComponentType::Body);
+    grow(registry.pool<SpriteComponent>(), ComponentType::Sprite);
+    grow(registry.pool<ControllerComponent>(), ComponentType::Controller);
+    grow(registry.pool<BounceBehavior>(), ComponentType::BounceBehavior);
+    grow(registry.pool<ProjectileBehavior>(), ComponentType::ProjectileBehavior);
+
+    // The objects themselves, parked until create() hands them out
+    if (freeObjects_.size() < count) {
+        freeObjects_.reserve(objects_.size() + count - freeObjects_.size());
+        while (freeObjects_.size() < count) {
+            objects_.emplace_back();
+            freeObjects_.push_back(&objects_.back());
+        }
+    }
+}
+
+GameObject* ObjectFactory::takeObject() {
+    if (freeObjects_.empty()) {
+        objects_.emplace_back();  // Not reserved: grow the store by one
+        return &objects_.back();
+    }
+    GameObject* object = freeObjects_.back();
+    freeObjects_.pop_back();
+    return object;
+}
+
+void ObjectRecycler::operator()(GameObject* object) const {
+    ObjectFactory::instance().recycle(object);
+}
+
+void ObjectFactory::recycle(GameObject* object) {
+    // Components (and their physics bodies) go back to the pools; the object
+    // is parked in its default state for the next create()
+    object->removeComponents();
+    object->setName("GameObject");
+    object->setTag(ObjectTag::None);
+    object->setActive(true);
+    freeObjects_.push_back(object);
+    liveObjects_--;
+}
+
+ObjectPtr ObjectFactory::create(PrototypeId id) {
+    if (id >= prototypes_.size()) return nullptr;
+    const ObjectPrototype& prototype = prototypes_[id];
+    return create(id, prototype.body.x, prototype.body.y);
+}
+
+ObjectPtr ObjectFactory::create(PrototypeId id, float x, float y) {
+    if (id >= prototypes_.size()) {
+        std::cerr << "ObjectFactory: invalid prototype id " << id << "\n";
+        return nullptr;
+    }
+    const ObjectPrototype& prototype = prototypes_[id];
+    GameObject* obj = takeObject();
+    obj->setName(prototype.type);  // Refers to the prototype, not a copy
+    obj->setTag(prototype.tag);
+
+    // Clone the prototype's component records into their pools in one pass.
+    // The object is fresh, so nothing is replaced and the mask is set once.
+    ComponentMask mask = prototype.components;
+    auto& registry = ComponentRegistry::instance();
+    BodyComponent* body = nullptr;
+    if (mask & componentBit(ComponentType::Body)) {
+        const ObjectPrototype::Body& settings = prototype.body;
+        body = obj->attachComponent(registry.pool<BodyComponent>(), x, y, settings.width, settings.height);
+        body->setVelocity(settings.velocityX, settings.velocityY);
+    }
+    if (mask & componentBit(ComponentType::Sprite)) {
+        auto* sprite = obj->attachComponent(registry.pool<SpriteComponent>(), prototype.sprite.texture,
+                                            textures_, renderer_);
+        sprite->setLayer(prototype.sprite.layer);
+    }
+    if (mask & componentBit(ComponentType::Controller)) {
+        obj->attachComponent(registry.pool<ControllerComponent>(), prototype.speed, screenWidth_);
+    }
+    if (mask & componentBit(ComponentType::BounceBehavior)) {
+        obj->attachComponent(registry.pool<BounceBehavior>(), screenWidth_, screenHeight_);
+    }
+    if (mask & componentBit(ComponentType::ProjectileBehavior)) {
+        obj->attachComponent(registry.pool<ProjectileBehavior>(), screenHeight_);
+    }
+    obj->mask_ = mask;
+    liveObjects_++;
+
+    // BOX2D INTEGRATION: the body's physics counterpart, at its final position
+    // (other pools were added to since, but the body pool was not)
+    if (body && world_) {
+        switch (prototype.body.physics) {
+            case BodyPhysics::Dynamic:
+                body->createPhysicsBody(world_, b2_dynamicBody, prototype.body.restitution);
+                break;
+            case BodyPhysics::Kinematic:
+                body->createPhysicsBody(world_, b2_kinematicBody, prototype.body.restitution);
+                break;
+            case BodyPhysics::Sensor:
+                body->createSensorBody(world_);  // Target: acorns report hits via sensor events
+                break;
+            case BodyPhysics::None:
+                break;
+        }
     }
-    std::cerr << "Unknown object type: " << type << "\n";
-    return nullptr;
+    return ObjectPtr(obj);
 }
 
 bool ObjectFactory::loadFromXML(const std::string& filepath) {
+    std::vector<ObjectDefinition> definitions;
+    if (!parseXML(filepath, definitions)) return false;
+    return setDefinitions(std::move(definitions));
+}
+
+bool ObjectFactory::loadFromBinary(SnapshotReader& reader) {
+    std::vector<ObjectDefinition> definitions;
+    if (!readBinary(reader, definitions)) {
+        std::cerr << "Failed to read packed object definitions\n";
+        return false;
+    }
+    return setDefinitions(std::move(definitions));
+}
+
+bool ObjectFactory::setDefinitions(std::vector<ObjectDefinition> definitions) {
+    // Live objects refer to their prototype's type name
+    if (liveObjects_ > 0) {
+        std::cerr << "ObjectFactory: cannot replace object definitions while " << liveObjects_
+                  << " objects are alive\n";
+        return false;
+    }
+    definitions_ = std::move(definitions);
+    prototypes_.clear();
+    prototypeIds_.clear();
+    for (const ObjectDefinition& object : definitions_) {
+        std::cout << "Loaded object definition: " << object.type;
+        if (!object.tag.empty()) std::cout << " tag=" << object.tag;
+        std::cout << "\n";
+        for (const ComponentDefinition& component : object.components) {
+            std::cout << "  - Component: " << component.type;
+            for (uint32_t n = 0; n < ComponentDefinition::NUMBER_COUNT; n++) {
+                auto number = static_cast<ComponentDefinition::Number>(n);
+                if (component.has(number)) {
+                    std::cout << " " << ComponentDefinition::numberName(number) << "=" << component.numbers[n];
+                }
+            }
+            if (component.fields & ComponentDefinition::TEXTURE) std::cout << " texture=" << component.texture;
+            if (component.fields & ComponentDefinition::PHYSICS) std::cout << " physics=" << component.physics;
+            std::cout << "\n";
+        }
+
+        prototypeIds_[object.type] = static_cast<PrototypeId>(prototypes_.size());
+        prototypes_.push_back(buildPrototype(object));
+    }
+    return true;
+}
+
+ObjectPrototype ObjectFactory::buildPrototype(const ObjectDefinition& definition) {
+    using Def = ComponentDefinition;
+    ObjectPrototype prototype;
+    prototype.type = definition.type;
+    if (!definition.tag.empty() && !findObjectTag(definition.tag, prototype.tag)) {
+        std::cerr << "Object " << definition.type << ": unknown tag " << definition.tag << "\n";
+    }
+
+    for (const ComponentDefinition& component : definition.components) {
+        ComponentType type;
+        if (!ComponentRegistry::findType(component.type, type)) {
+            std::cerr << "Object " << definition.type << ": unknown component " << component.type << "\n";
+            continue;
+        }
+        prototype.components |= componentBit(type);
+        switch (type) {
+            case ComponentType::Body: {
+                ObjectPrototype::Body& body = prototype.body;
+                body.x = component.get(Def::X, body.x);
+                body.y = component.get(Def::Y, body.y);
+                body.width = component.get(Def::WIDTH, body.width);
+                body.height = component.get(Def::HEIGHT, body.height);
+                body.velocityX = component.get(Def::VELOCITY_X, body.velocityX);
+                body.velocityY = component.get(Def::VELOCITY_Y, body.velocityY);
+                body.restitution = component.get(Def::RESTITUTION, body.restitution);
+                if (component.physics == "dynamic") {
+                    body.physics = BodyPhysics::Dynamic;
+                } else if (component.physics == "kinematic") {
+                    body.physics = BodyPhysics::Kinematic;
+                } else if (component.physics == "sensor") {
+                    body.physics = BodyPhysics::Sensor;
+                } else if (!component.physics.empty() && component.physics != "none") {
+                    std::cerr << "Object " << definition.type << ": unknown physics " << component.physics
+                              << " (none, dynamic, kinematic, sensor)\n";
+                }
+                break;
+            }
+            case ComponentType::Sprite:
+                prototype.sprite.textureName = component.texture;
+                prototype.sprite.layer = static_cast<int>(component.get(Def::LAYER, 0.0f));
+                break;
+            case ComponentType::Controller:
+                prototype.speed = component.get(Def::SPEED, prototype.speed);
+                break;
+            default:
+                break;  // Behaviors only need the screen size
+        }
+    }
+    return prototype;
+}
+
+bool ObjectFactory::parseXML(const std::string& filepath, std::vector<ObjectDefinition>& definitions) {
     tinyxml2::XMLDocument doc;
     if (doc.LoadFile(filepath.c_str()) != tinyxml2::XML_SUCCESS) {
         std::cerr << "Failed to load ObjectFactory XML: " << filepath << "\n";
@@ -37,27 +279,74 @@ bool ObjectFactory::loadFromXML(const std::string& filepath) {
     for (auto* objDef = root->FirstChildElement("Object"); objDef; objDef = objDef->NextSiblingElement("Object")) {
         const char* typeName = objDef->Attribute("type");
         if (!typeName) continue;
+        ObjectDefinition object;
+        object.type = typeName;
+        if (const char* tag = objDef->Attribute("tag")) object.tag = tag;
         
-        std::cout << "Loaded object definition: " << typeName << "\n";
-        
-        // Parse components and their attributes
+        // Components and the attributes they set
         for (auto* compDef = objDef->FirstChildElement("Component"); compDef; compDef = compDef->NextSiblingElement("Component")) {
             const char* compType = compDef->Attribute("type");
-            if (compType) {
-                std::cout << "  - Component: " << compType;
-                
-                // Log component parameters
-                if (compDef->Attribute("x")) std::cout << " x=" << compDef->Attribute("x");
-                if (compDef->Attribute("y")) std::cout << " y=" << compDef->Attribute("y");
-                if (compDef->Attribute("width")) std::cout << " width=" << compDef->Attribute("width");
-                if (compDef->Attribute("height")) std::cout << " height=" << compDef->Attribute("height");
-                if (compDef->Attribute("speed")) std::cout << " speed=" << compDef->Attribute("speed");
-                if (compDef->Attribute("texture")) std::cout << " texture=" << compDef->Attribute("texture");
-                
-                std::cout << "\n";
+            if (!compType) continue;
+            ComponentDefinition component;
+            component.type = compType;
+            for (uint32_t n = 0; n < ComponentDefinition::NUMBER_COUNT; n++) {
+                const char* name = ComponentDefinition::numberName(static_cast<ComponentDefinition::Number>(n));
+                if (compDef->QueryFloatAttribute(name, &component.numbers[n]) == tinyxml2::XML_SUCCESS) {
+                    component.fields |= 1u << n;
+                }
+            }
+            if (const char* texture = compDef->Attribute("texture")) {
+                component.texture = texture;
+                component.fields |= ComponentDefinition::TEXTURE;
+            }
+            if (const char* physics = compDef->Attribute("physics")) {
+                component.physics = physics;
+                component.fields |= ComponentDefinition::PHYSICS;
             }
+            object.components.push_back(std::move(component));
         }
+        definitions.push_back(std::move(object));
     }
     
     return true;
 }
+
+void ObjectFactory::writeBinary(SnapshotWriter& writer, const std::vector<ObjectDefinition>& definitions) {
+    writer.write(BINARY_VERSION);
+    writer.write(static_cast<uint32_t>(definitions.size()));
+    for (const ObjectDefinition& object : definitions) {
+        writer.writeString(object.type);
+        writer.writeString(object.tag);
+        writer.write(static_cast<uint32_t>(object.components.size()));
+        for (const ComponentDefinition& component : object.components) {
+            writer.writeString(component.type);
+            writer.write(component.fields);
+            writer.writeArray(component.numbers, ComponentDefinition::NUMBER_COUNT);
+            writer.writeString(component.texture);
+            writer.writeString(component.physics);
+        }
+    }
+}
+
+bool ObjectFactory::readBinary(SnapshotReader& reader, std::vector<ObjectDefinition>& definitions) {
+    uint32_t version = 0, objectCount = 0;
+    if (!reader.read(version) || version != BINARY_VERSION || !reader.read(objectCount)) return false;
+    if (objectCount > reader.remaining()) return false;  // Corrupt count
+    definitions.resize(objectCount);
+    for (ObjectDefinition& object : definitions) {
+        uint32_t componentCount = 0;
+        reader.readString(object.type);
+        reader.readString(object.tag);
+        if (!reader.read(componentCount) || componentCount > reader.remaining()) return false;
+        object.components.resize(componentCount);
+        for (ComponentDefinition& component : object.components) {
+            reader.readString(component.type);
+            reader.read(component.fields);
+            reader.readArray(component.numbers, ComponentDefinition::NUMBER_COUNT);
+            reader.readString(component.texture);
+            reader.readString(component.physics);
+            if (!reader.ok()) return false;
+        }
+    }
+    return reader.ok();
+}
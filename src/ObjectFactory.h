@@ -1,36 +1,145 @@
 #pragma once
+#include <deque>
 #include <memory>
 #include <string>
 #include <unordered_map>
-#include <functional>
+#include <vector>
 #include "GameObject.h"
+#include "TextureAtlas.h"
 #include <SDL.h>
 
-struct ObjectParams {
-    float x = 0, y = 0;
-    float width = 0, height = 0;
-    float speed = 0;
-    float velocityX = 0, velocityY = 0;
-    std::string textureName;
-    SDL_Renderer* renderer = nullptr;
-    SDL_Texture* texture = nullptr;
-    int screenWidth = 800;
-    int screenHeight = 600;
+class Graphics;
+class PhysicsWorld;
+class SnapshotWriter;
+class SnapshotReader;
+
+// One <Component> of an object definition, as written in objects.xml. Only
+// the attributes present in the XML are marked in `fields`.
+struct ComponentDefinition {
+    enum Number : uint32_t {
+        X, Y, WIDTH, HEIGHT, SPEED, VELOCITY_X, VELOCITY_Y, RESTITUTION, LAYER,
+        NUMBER_COUNT
+    };
+    static constexpr uint32_t TEXTURE = 1u << NUMBER_COUNT;
+    static constexpr uint32_t PHYSICS = 1u << (NUMBER_COUNT + 1);
+
+    std::string type;
+    uint32_t fields = 0;
+    float numbers[NUMBER_COUNT] = {};
+    std::string texture;
+    std::string physics;  // BodyComponent: none, dynamic, kinematic or sensor
+
+    bool has(Number number) const { return (fields & (1u << number)) != 0; }
+    float get(Number number, float fallback) const { return has(number) ? numbers[number] : fallback; }
+    static const char* numberName(Number number);  // XML attribute name
+};
+
+struct ObjectDefinition {
+    std::string type;
+    std::string tag;  // ObjectTag name; empty = None
+    std::vector<ComponentDefinition> components;
+};
+
+// Physics body a prototype's BodyComponent gets when created
+enum class BodyPhysics : uint8_t {
+    None,
+    Dynamic,    // Affected by gravity and forces
+    Kinematic,  // Moved by the game
+    Sensor      // Kinematic sensor following the object (a hit target)
 };
 
+// A resolved object definition: the component set and each component's
+// starting values, with the texture handle looked up once. create() copies
+// it into the component pools; nothing is looked up by name per spawn.
+struct ObjectPrototype {
+    std::string type;
+    ObjectTag tag = ObjectTag::None;
+    ComponentMask components = 0;
+
+    struct Body {
+        float x = 0, y = 0;
+        float width = 0, height = 0;
+        float velocityX = 0, velocityY = 0;
+        BodyPhysics physics = BodyPhysics::None;
+        float restitution = 0.5f;
+    } body;
+
+    struct Sprite {
+        std::string textureName;
+        TextureHandle texture;  // Set by resolveTextures()
+        int layer = 0;
+    } sprite;
+
+    float speed = 0;  // ControllerComponent
+};
+
+// Deleter for objects made by ObjectFactory::create(): the object goes back
+// to the factory's store rather than to the heap
+struct ObjectRecycler {
+    void operator()(GameObject* object) const;
+};
+using ObjectPtr = std::unique_ptr<GameObject, ObjectRecycler>;
+
 class ObjectFactory {
 public:
-    using CreateFunc = std::function<std::unique_ptr<GameObject>(const ObjectParams&)>;
-    
+    using PrototypeId = uint32_t;
+    static constexpr PrototypeId INVALID_PROTOTYPE = UINT32_MAX;
+
     static ObjectFactory& instance();
-    
-    void registerType(const std::string& type, CreateFunc func);
-    std::unique_ptr<GameObject> create(const std::string& type, const ObjectParams& params);
-    
-    // Load object definitions from XML
+
+    // Load object definitions from XML, or from the binary record the asset
+    // packer stores in assets.pak. Each definition becomes a prototype.
+    // Fails while objects created from the previous prototypes are alive.
     bool loadFromXML(const std::string& filepath);
+    bool loadFromBinary(SnapshotReader& reader);
+    const std::vector<ObjectDefinition>& getDefinitions() const { return definitions_; }
+
+    // Setup, once the prototypes are loaded: what created objects attach to,
+    // and sprite texture handles from the (built) texture atlas
+    void setWorld(PhysicsWorld* world, SDL_Renderer* renderer, int screenWidth, int screenHeight);
+    int resolveTextures(const Graphics& graphics);  // Returns textures not found
+
+    // Look a type up once and keep the id; prototypes may be adjusted (e.g.
+    // from config.xml) before objects are created from them
+    PrototypeId findPrototype(const std::string& type) const;
+    ObjectPrototype* getPrototype(PrototypeId id);
+    size_t getPrototypeCount() const { return prototypes_.size(); }
+
+    // Grow the object store and the component pools so `count` more objects
+    // of this prototype can be created without allocating
+    void reserve(PrototypeId id, size_t count);
+
+    ObjectPtr create(PrototypeId id);
+    ObjectPtr create(PrototypeId id, float x, float y);
+    size_t getLiveObjectCount() const { return liveObjects_; }
+
+    static bool parseXML(const std::string& filepath, std::vector<ObjectDefinition>& definitions);
+    static constexpr uint32_t BINARY_VERSION = 2;
+    static void writeBinary(SnapshotWriter& writer, const std::vector<ObjectDefinition>& definitions);
+    static bool readBinary(SnapshotReader& reader, std::vector<ObjectDefinition>& definitions);
 
 private:
+    friend struct ObjectRecycler;
+
     ObjectFactory() = default;
-    std::unordered_map<std::string, CreateFunc> creators_;
+    bool setDefinitions(std::vector<ObjectDefinition> definitions);
+    GameObject* takeObject();
+    void recycle(GameObject* object);
+    static ObjectPrototype buildPrototype(const ObjectDefinition& definition);
+
+    std::vector<ObjectDefinition> definitions_;
+    std::vector<ObjectPrototype> prototypes_;
+    std::unordered_map<std::string, PrototypeId> prototypeIds_;  // Setup-time lookups only
+
+    // Every object the factory has made; a deque keeps addresses stable as it
+    // grows. Destroyed objects are stripped and parked on freeObjects_.
+    std::deque<GameObject> objects_;
+    std::vector<GameObject*> freeObjects_;
+    size_t liveObjects_ = 0;
+
+    PhysicsWorld* world_ = nullptr;
+    SDL_Renderer* renderer_ = nullptr;
+    const TextureAtlas* textures_ = nullptr;
+    int screenWidth_ = 800;
+    int screenHeight_ = 600;
 };
@@ -1,27 +1,59 @@
 #include "PhysicsWorld.h"
 #include "BodyComponent.h"
+#include "ComponentRegistry.h"
+#include "Snapshot.h"
+#include "TaskSystem.h"
 #include <iostream>
 
 // BOX2D INTEGRATION: Create Box2D physics world with configurable gravity
 // This wrapper manages the b2WorldId which represents the entire physics simulation
 PhysicsWorld::PhysicsWorld(float gravityX, float gravityY) {
+    createWorld({gravityX, gravityY});
+}
+
+PhysicsWorld::~PhysicsWorld() {
+    if (B2_IS_NON_NULL(worldId_)) {
+        b2DestroyWorld(worldId_);
+    }
+}
+
+void PhysicsWorld::createWorld(b2Vec2 gravity) {
     // Initialize world definition with default settings
     b2WorldDef worldDef = b2DefaultWorldDef();
     
     // Set gravity vector (typically {0, positive_value} for downward gravity)
-    worldDef.gravity = {gravityX, gravityY};
+    worldDef.gravity = gravity;
+    
+    // Hand Box2D our worker threads (it never creates threads itself)
+    if (taskSystem_) {
+        worldDef.workerCount = taskSystem_->getWorkerCount();
+        worldDef.enqueueTask = &TaskSystem::enqueueBox2DTask;
+        worldDef.finishTask = &TaskSystem::finishBox2DTask;
+        worldDef.userTaskContext = taskSystem_;
+    }
     
     // Create the Box2D world - this allocates the physics simulation context
+    // Contacts are read from the world's event buffers after each step
     worldId_ = b2CreateWorld(&worldDef);
-    
-    // Register contact callback for collision detection
-    b2World_SetPreSolveCallback(worldId_, contactBeginCallback, this);
 }
 
-PhysicsWorld::~PhysicsWorld() {
+bool PhysicsWorld::setTaskSystem(TaskSystem* taskSystem) {
+    if (B2_IS_NON_NULL(worldId_) && b2World_GetCounters(worldId_).bodyCount > 0) {
+        std::cerr << "PhysicsWorld: task system must be set before bodies are created\n";
+        return false;
+    }
+    
+    b2Vec2 gravity = getGravity();
     if (B2_IS_NON_NULL(worldId_)) {
         b2DestroyWorld(worldId_);
     }
+    taskSystem_ = taskSystem;
+    createWorld(gravity);
+    return true;
+}
+
+int PhysicsWorld::getWorkerCount() const {
+    return taskSystem_ ? taskSystem_->getWorkerCount() : 1;
 }
 
 // BOX2D INTEGRATION: Advance physics simulation by one time step
@@ -33,6 +65,92 @@ void PhysicsWorld::step(float deltaTime, int subStepCount) {
         // subStepCount: number of sub-steps for stability (higher = more accurate but slower)
         b2World_Step(worldId_, deltaTime, subStepCount);
     }
+    
+    // BOX2D-SDL SYNC: Copy moved bodies into their components before anyone reads them
+    syncMovedBodies();
+    
+    // BOX2D REQUIREMENT: Contact Listening - deliver this step's contacts in one batch
+    if (contactCallback_) {
+        gatherContactEvents();
+        if (!contactEvents_.empty()) {
+            contactCallback_(contactEvents_);
+        }
+    }
+}
+
+// BOX2D-SDL SYNC: One pass over Box2D's move events instead of querying every body.
+// Sleeping and static bodies produce no event and are skipped.
+void PhysicsWorld::syncMovedBodies() {
+    lastSyncCount_ = 0;
+    if (B2_IS_NULL(worldId_)) return;
+    
+    b2BodyEvents events = b2World_GetBodyEvents(worldId_);
+    for (int i = 0; i < events.moveCount; i++) {
+        const b2BodyMoveEvent& move = events.moveEvents[i];
+        if (auto* body = static_cast<BodyComponent*>(move.userData)) {
+            body->applyPhysicsTransform(move.transform);
+            lastSyncCount_++;
+        }
+    }
+}
+
+void PhysicsWorld::gatherContactEvents() {
+    contactEvents_.clear();
+    if (B2_IS_NULL(worldId_)) return;
+    
+    // Events are only generated for new/ended contacts, not for every touching pair
+    b2ContactEvents events = b2World_GetContactEvents(worldId_);
+    
+    // BOX2D REQUIREMENT: userData retrieval for game object identification
+    // Get BodyComponent pointers that were stored in b2Body_SetUserData()
+    auto bodyOf = [](b2ShapeId shapeId) -> BodyComponent* {
+        if (!b2Shape_IsValid(shapeId)) return nullptr;  // Destroyed since the contact ended
+        return static_cast<BodyComponent*>(b2Body_GetUserData(b2Shape_GetBody(shapeId)));
+    };
+    
+    for (int i = 0; i < events.beginCount; i++) {
+        const b2ContactBeginTouchEvent& e = events.beginEvents[i];
+        BodyComponent* a = bodyOf(e.shapeIdA);
+        BodyComponent* b = bodyOf(e.shapeIdB);
+        if (a && b) {
+            contactEvents_.push_back({ContactEvent::Type::Begin, a, b, {0.0f, 0.0f}, 0.0f});
+        }
+    }
+    for (int i = 0; i < events.endCount; i++) {
+        const b2ContactEndTouchEvent& e = events.endEvents[i];
+        BodyComponent* a = bodyOf(e.shapeIdA);
+        BodyComponent* b = bodyOf(e.shapeIdB);
+        if (a && b) {
+            contactEvents_.push_back({ContactEvent::Type::End, a, b, {0.0f, 0.0f}, 0.0f});
+        }
+    }
+    for (int i = 0; i < events.hitCount; i++) {
+        const b2ContactHitEvent& e = events.hitEvents[i];
+        BodyComponent* a = bodyOf(e.shapeIdA);
+        BodyComponent* b = bodyOf(e.shapeIdB);
+        if (a && b) {
+            contactEvents_.push_back({ContactEvent::Type::Hit, a, b, e.point, e.approachSpeed});
+        }
+    }
+    
+    // Sensor overlaps (targets), found by the broadphase during the step
+    b2SensorEvents sensorEvents = b2World_GetSensorEvents(worldId_);
+    for (int i = 0; i < sensorEvents.beginCount; i++) {
+        const b2SensorBeginTouchEvent& e = sensorEvents.beginEvents[i];
+        BodyComponent* sensor = bodyOf(e.sensorShapeId);
+        BodyComponent* visitor = bodyOf(e.visitorShapeId);
+        if (sensor && visitor) {
+            contactEvents_.push_back({ContactEvent::Type::SensorBegin, sensor, visitor, {0.0f, 0.0f}, 0.0f});
+        }
+    }
+    for (int i = 0; i < sensorEvents.endCount; i++) {
+        const b2SensorEndTouchEvent& e = sensorEvents.endEvents[i];
+        BodyComponent* sensor = bodyOf(e.sensorShapeId);
+        BodyComponent* visitor = bodyOf(e.visitorShapeId);
+        if (sensor && visitor) {
+            contactEvents_.push_back({ContactEvent::Type::SensorEnd, sensor, visitor, {0.0f, 0.0f}, 0.0f});
+        }
+    }
 }
 
 void PhysicsWorld::setGravity(float x, float y) {
@@ -48,25 +166,64 @@ b2Vec2 PhysicsWorld::getGravity() const {
     return {0.0f, 0.0f};
 }
 
-void PhysicsWorld::setContactCallback(CollisionCallback callback) {
+void PhysicsWorld::setContactCallback(ContactCallback callback) {
     contactCallback_ = callback;
 }
 
-bool PhysicsWorld::contactBeginCallback(b2ShapeId shapeIdA, b2ShapeId shapeIdB, b2Manifold* manifold, void* context) {
-    PhysicsWorld* world = static_cast<PhysicsWorld*>(context);
-    if (!world || !world->contactCallback_) return true;
-    
-    // Get bodies from shapes
-    b2BodyId bodyIdA = b2Shape_GetBody(shapeIdA);
-    b2BodyId bodyIdB = b2Shape_GetBody(shapeIdB);
+// Snapshot layout: magic, body count, then one BodyComponent::State per body
+// in body-pool order. The pool only reorders on add/remove, which also changes
+// the recorded Box2D body ids, so a stale snapshot is always detected.
+static constexpr uint32_t SNAPSHOT_MAGIC = 0x50485953;  // "PHYS"
+
+void PhysicsWorld::saveSnapshot(SnapshotWriter& writer) const {
+    auto& bodies = ComponentRegistry::instance().pool<BodyComponent>();
+    writer.write(SNAPSHOT_MAGIC);
+    writer.write(static_cast<uint32_t>(bodies.size()));
+    for (const BodyComponent& body : bodies) {
+        writer.write(body.saveState());
+    }
+}
+
+bool PhysicsWorld::restoreSnapshot(SnapshotReader& reader) {
+    if (!readSnapshot(reader)) return false;
+    applySnapshot();
+    return true;
+}
+
+bool PhysicsWorld::readSnapshot(SnapshotReader& reader) {
+    auto& bodies = ComponentRegistry::instance().pool<BodyComponent>();
     
-    // Get user data (BodyComponent pointers)
-    void* userDataA = b2Body_GetUserData(bodyIdA);
-    void* userDataB = b2Body_GetUserData(bodyIdB);
+    uint32_t magic = 0;
+    uint32_t count = 0;
+    if (!reader.read(magic) || !reader.read(count) || magic != SNAPSHOT_MAGIC) {
+        std::cerr << "PhysicsWorld: not a physics snapshot\n";
+        return false;
+    }
+    if (count != bodies.size()) {
+        std::cerr << "PhysicsWorld: snapshot has " << count << " bodies, world has " << bodies.size() << "\n";
+        return false;
+    }
     
-    if (userDataA && userDataB) {
-        world->contactCallback_(userDataA, userDataB);
+    restoreStates_.resize(count);
+    if (!reader.readArray(restoreStates_.data(), count)) {
+        std::cerr << "PhysicsWorld: truncated snapshot\n";
+        return false;
     }
     
-    return true; // Allow collision
+    // Validate everything before anything is written back
+    size_t i = 0;
+    for (const BodyComponent& body : bodies) {
+        if (!body.matchesState(restoreStates_[i++])) {
+            std::cerr << "PhysicsWorld: bodies changed since the snapshot was taken\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+void PhysicsWorld::applySnapshot() {
+    size_t i = 0;
+    for (BodyComponent& body : ComponentRegistry::instance().pool<BodyComponent>()) {
+        body.restoreState(restoreStates_[i++]);
+    }
 }
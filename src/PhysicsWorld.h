@@ -1,7 +1,27 @@
 #pragma once
 
 #include <box2d/box2d.h>
+#include <cstdint>
 #include <functional>
+#include <vector>
+
+#include "BodyComponent.h"
+
+class TaskSystem;
+class SnapshotWriter;
+class SnapshotReader;
+
+// A contact reported by Box2D for the last step, already resolved to the
+// BodyComponents stored in each body's userData
+struct ContactEvent {
+    enum class Type : uint8_t { Begin, End, Hit, SensorBegin, SensorEnd };
+
+    Type type;
+    BodyComponent* bodyA;  // The sensor for sensor events
+    BodyComponent* bodyB;  // The visiting shape's body for sensor events
+    b2Vec2 point;          // Hit events only
+    float approachSpeed;   // Hit events only
+};
 
 class PhysicsWorld {
 public:
@@ -14,17 +34,43 @@ public:
     // Access the Box2D world ID
     b2WorldId getWorldId() const { return worldId_; }
 
+    // Multithreaded stepping: recreates the Box2D world with the task system's
+    // workers wired into b2WorldDef. Must be called before any body is created.
+    bool setTaskSystem(TaskSystem* taskSystem);
+    int getWorkerCount() const;
+
     // World settings
     void setGravity(float x, float y);
     b2Vec2 getGravity() const;
     
-    // Collision callback
-    using CollisionCallback = std::function<void(void* bodyA, void* bodyB)>;
-    void setContactCallback(CollisionCallback callback);
+    // State snapshot of every BodyComponent and its Box2D body (transforms,
+    // velocities, enabled/awake). Restoring writes it back into the same bodies
+    // in place; it fails without touching anything if bodies were created or
+    // destroyed since the snapshot was taken. readSnapshot/applySnapshot are
+    // the two halves of restoreSnapshot, for callers that validate several
+    // sections before applying any of them.
+    void saveSnapshot(SnapshotWriter& writer) const;
+    bool restoreSnapshot(SnapshotReader& reader);
+    bool readSnapshot(SnapshotReader& reader);  // Reads and validates only
+    void applySnapshot();                       // Right after readSnapshot succeeded
+    
+    // Bodies whose transforms were copied into their BodyComponent by the last step
+    int getLastSyncCount() const { return lastSyncCount_; }
+    
+    // Collision callback: called once per step (on the stepping thread) with
+    // every contact begin/end/hit and sensor begin/end event Box2D buffered during that step
+    using ContactCallback = std::function<void(const std::vector<ContactEvent>& events)>;
+    void setContactCallback(ContactCallback callback);
 
 private:
-    b2WorldId worldId_;
-    CollisionCallback contactCallback_;
-    
-    static bool contactBeginCallback(b2ShapeId shapeIdA, b2ShapeId shapeIdB, b2Manifold* manifold, void* context);
+    void createWorld(b2Vec2 gravity);
+    void syncMovedBodies();
+    void gatherContactEvents();
+
+    b2WorldId worldId_ = b2_nullWorldId;
+    TaskSystem* taskSystem_ = nullptr;
+    ContactCallback contactCallback_;
+    std::vector<ContactEvent> contactEvents_;  // Reused every step
+    std::vector<BodyComponent::State> restoreStates_;  // Reused by restoreSnapshot
+    int lastSyncCount_ = 0;
 };
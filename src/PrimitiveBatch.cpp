@@ -0,0 +1,114 @@
+#include "PrimitiveBatch.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+static constexpr float PI = 3.14159265359f;
+
+void PrimitiveBatch::addQuad(float x0, float y0, float x1, float y1, float x2, float y2, float x3, float y3,
+                             SDL_Color color) {
+    int base = static_cast<int>(vertices_.size());
+    vertices_.push_back({{x0, y0}, color, {0.0f, 0.0f}});
+    vertices_.push_back({{x1, y1}, color, {0.0f, 0.0f}});
+    vertices_.push_back({{x2, y2}, color, {0.0f, 0.0f}});
+    vertices_.push_back({{x3, y3}, color, {0.0f, 0.0f}});
+    const int quadIndices[6] = {0, 1, 2, 0, 2, 3};
+    for (int index : quadIndices) {
+        indices_.push_back(base + index);
+    }
+}
+
+void PrimitiveBatch::addFilledRect(const SDL_FRect& rect, SDL_Color color) {
+    if (rect.w <= 0.0f || rect.h <= 0.0f) return;
+    float x1 = rect.x + rect.w;
+    float y1 = rect.y + rect.h;
+    addQuad(rect.x, rect.y, x1, rect.y, x1, y1, rect.x, y1, color);
+    shapes_++;
+}
+
+void PrimitiveBatch::addRect(const SDL_FRect& rect, SDL_Color color, float thickness) {
+    if (rect.w <= 0.0f || rect.h <= 0.0f) return;
+    // Four edge strips inside the rectangle; top and bottom span the full
+    // width, the sides fill in between so corners are not covered twice
+    float t = std::min(thickness, std::min(rect.w, rect.h) * 0.5f);
+    float x1 = rect.x + rect.w;
+    float y1 = rect.y + rect.h;
+    addQuad(rect.x, rect.y, x1, rect.y, x1, rect.y + t, rect.x, rect.y + t, color);
+    addQuad(rect.x, y1 - t, x1, y1 - t, x1, y1, rect.x, y1, color);
+    addQuad(rect.x, rect.y + t, rect.x + t, rect.y + t, rect.x + t, y1 - t, rect.x, y1 - t, color);
+    addQuad(x1 - t, rect.y + t, x1, rect.y + t, x1, y1 - t, x1 - t, y1 - t, color);
+    shapes_++;
+}
+
+void PrimitiveBatch::addLine(float x1, float y1, float x2, float y2, SDL_Color color, float thickness) {
+    // A quad around the segment: pixel coordinates name pixel corners, so move
+    // to pixel centres and extend half a pixel past each end to cover the
+    // end pixels like SDL_RenderDrawLine does
+    float cx1 = x1 + 0.5f, cy1 = y1 + 0.5f;
+    float cx2 = x2 + 0.5f, cy2 = y2 + 0.5f;
+    float dx = cx2 - cx1;
+    float dy = cy2 - cy1;
+    float length = std::sqrt(dx * dx + dy * dy);
+    float half = thickness * 0.5f;
+    float ux = 1.0f, uy = 0.0f;  // Degenerate line: a single dot
+    if (length > 0.0f) {
+        ux = dx / length;
+        uy = dy / length;
+    }
+    float ex = ux * half, ey = uy * half;    // Along the line
+    float nx = -uy * half, ny = ux * half;   // Across the line
+    addQuad(cx1 - ex + nx, cy1 - ey + ny,
+            cx2 + ex + nx, cy2 + ey + ny,
+            cx2 + ex - nx, cy2 + ey - ny,
+            cx1 - ex - nx, cy1 - ey - ny, color);
+    shapes_++;
+}
+
+int PrimitiveBatch::circleSegments(float radius) {
+    // Sagitta of one segment: r * (1 - cos(pi / n)) <= 0.25 px
+    if (radius <= 1.0f) return 8;
+    float maxError = std::min(0.25f, radius);
+    int segments = static_cast<int>(std::ceil(PI / std::acos(1.0f - maxError / radius)));
+    return std::clamp(segments, 8, 256);
+}
+
+void PrimitiveBatch::addFilledCircle(float centerX, float centerY, float radius, SDL_Color color) {
+    addFilledCircle(centerX, centerY, radius, color, color);
+}
+
+void PrimitiveBatch::addFilledCircle(float centerX, float centerY, float radius, SDL_Color centerColor,
+                                     SDL_Color edgeColor) {
+    if (radius <= 0.0f) return;
+    int segments = circleSegments(radius);
+    int center = static_cast<int>(vertices_.size());
+    vertices_.push_back({{centerX, centerY}, centerColor, {0.0f, 0.0f}});
+
+    // Rim vertices once each; the fan closes back onto the first one
+    float step = 2.0f * PI / segments;
+    for (int i = 0; i < segments; i++) {
+        float angle = i * step;
+        vertices_.push_back({{centerX + radius * std::cos(angle), centerY + radius * std::sin(angle)},
+                             edgeColor, {0.0f, 0.0f}});
+    }
+    for (int i = 0; i < segments; i++) {
+        indices_.push_back(center);
+        indices_.push_back(center + 1 + i);
+        indices_.push_back(center + 1 + (i + 1) % segments);
+    }
+    shapes_++;
+}
+
+int PrimitiveBatch::flush(SDL_Renderer* renderer) {
+    int drawCalls = 0;
+    if (!indices_.empty()) {
+        if (SDL_RenderGeometry(renderer, nullptr, vertices_.data(), static_cast<int>(vertices_.size()),
+                               indices_.data(), static_cast<int>(indices_.size())) != 0) {
+            std::cerr << "PrimitiveBatch: SDL_RenderGeometry failed: " << SDL_GetError() << "\n";
+        }
+        drawCalls = 1;
+    }
+    vertices_.clear();
+    indices_.clear();
+    shapes_ = 0;
+    return drawCalls;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <SDL.h>
+#include <vector>
+
+// Collects untextured shapes (filled rects, outlines, lines, filled circles)
+// as coloured triangles and submits them with one SDL_RenderGeometry call.
+// Colour is per vertex, so differently coloured shapes share the call;
+// shapes are drawn in the order they were added.
+class PrimitiveBatch {
+public:
+    PrimitiveBatch() = default;
+
+    void addFilledRect(const SDL_FRect& rect, SDL_Color color);
+    // Outline covering the same pixels as SDL_RenderDrawRect (for thickness 1)
+    void addRect(const SDL_FRect& rect, SDL_Color color, float thickness = 1.0f);
+    void addLine(float x1, float y1, float x2, float y2, SDL_Color color, float thickness = 1.0f);
+    // Triangle fan; the edge colour defaults to the centre colour
+    void addFilledCircle(float centerX, float centerY, float radius, SDL_Color color);
+    void addFilledCircle(float centerX, float centerY, float radius, SDL_Color centerColor, SDL_Color edgeColor);
+
+    // Draw everything queued. Returns the number of draw calls issued (0 or 1).
+    int flush(SDL_Renderer* renderer);
+
+    size_t getShapeCount() const { return shapes_; }
+    bool empty() const { return indices_.empty(); }
+
+    // Rim segments for a circle: enough that the polygon stays within a
+    // quarter pixel of the true edge
+    static int circleSegments(float radius);
+
+private:
+    void addQuad(float x0, float y0, float x1, float y1, float x2, float y2, float x3, float y3, SDL_Color color);
+
+    // Reused every frame
+    std::vector<SDL_Vertex> vertices_;
+    std::vector<int> indices_;
+    size_t shapes_ = 0;
+};
@@ -0,0 +1,140 @@
+#include "ProjectilePool.h"
+#include "BodyComponent.h"
+#include "BehaviorComponent.h"
+#include "Snapshot.h"
+
+void ProjectilePool::init(size_t capacity, const CreateFunc& create) {
+    objects_.clear();
+    free_.clear();
+    active_.clear();
+    activeIndices_.clear();
+    highWaterMark_ = 0;
+    exhaustedCount_ = 0;
+
+    objects_.reserve(capacity);
+    free_.reserve(capacity);
+    active_.reserve(capacity);
+    activeIndices_.reserve(capacity);
+
+    for (size_t i = 0; i < capacity && i < UINT16_MAX; i++) {
+        auto projectile = create();
+        if (!projectile) break;
+        park(projectile.get());
+        free_.push_back(static_cast<uint16_t>(i));
+        objects_.push_back(std::move(projectile));
+    }
+}
+
+GameObject* ProjectilePool::acquire() {
+    if (free_.empty()) {
+        exhaustedCount_++;
+        return nullptr;
+    }
+
+    uint16_t index = free_.back();
+    free_.pop_back();
+    GameObject* projectile = objects_[index].get();
+
+    if (auto* behavior = projectile->getComponent<ProjectileBehavior>()) {
+        behavior->reset();
+    }
+    if (auto* body = projectile->getComponent<BodyComponent>()) {
+        body->setPhysicsEnabled(true);
+    }
+    projectile->setActive(true);
+
+    active_.push_back(projectile);
+    activeIndices_.push_back(index);
+    if (active_.size() > highWaterMark_) {
+        highWaterMark_ = active_.size();
+    }
+    return projectile;
+}
+
+void ProjectilePool::releaseInactive() {
+    // Swap-remove parked projectiles from the active list
+    for (size_t i = 0; i < active_.size();) {
+        GameObject* projectile = active_[i];
+        if (projectile->isActive()) {
+            i++;
+            continue;
+        }
+        park(projectile);
+        free_.push_back(activeIndices_[i]);
+        active_[i] = active_.back();
+        active_.pop_back();
+        activeIndices_[i] = activeIndices_.back();
+        activeIndices_.pop_back();
+    }
+}
+
+void ProjectilePool::releaseAll() {
+    for (GameObject* projectile : active_) {
+        park(projectile);
+    }
+    free_.insert(free_.end(), activeIndices_.begin(), activeIndices_.end());
+    active_.clear();
+    activeIndices_.clear();
+}
+
+void ProjectilePool::park(GameObject* projectile) {
+    projectile->setActive(false);
+    if (auto* body = projectile->getComponent<BodyComponent>()) {
+        body->setPhysicsEnabled(false);
+    }
+}
+
+void ProjectilePool::saveState(SnapshotWriter& writer) const {
+    writer.write(static_cast<uint16_t>(objects_.size()));
+    writer.write(static_cast<uint16_t>(active_.size()));
+    writer.writeArray(activeIndices_.data(), activeIndices_.size());
+    // Free order decides which projectile fires next, so keep it too
+    writer.writeArray(free_.data(), free_.size());
+}
+
+bool ProjectilePool::restoreState(SnapshotReader& reader) {
+    if (!readState(reader)) return false;
+    applyState();
+    return true;
+}
+
+bool ProjectilePool::readState(SnapshotReader& reader) {
+    uint16_t capacity = 0;
+    uint16_t activeCount = 0;
+    if (!reader.read(capacity) || !reader.read(activeCount) ||
+        capacity != objects_.size() || activeCount > capacity) {
+        return false;
+    }
+    
+    restoreIndices_.resize(capacity);
+    if (!reader.readArray(restoreIndices_.data(), capacity)) return false;
+    // Every projectile exactly once, in flight or free
+    restoreSeen_.assign(capacity, 0);
+    for (uint16_t index : restoreIndices_) {
+        if (index >= capacity || restoreSeen_[index]) return false;
+        restoreSeen_[index] = 1;
+    }
+    restoreActiveCount_ = activeCount;
+    return true;
+}
+
+void ProjectilePool::applyState() {
+    active_.clear();
+    activeIndices_.clear();
+    free_.clear();
+    for (size_t i = 0; i < restoreIndices_.size(); i++) {
+        uint16_t index = restoreIndices_[i];
+        GameObject* projectile = objects_[index].get();
+        bool inFlight = i < restoreActiveCount_;
+        projectile->setActive(inFlight);
+        if (inFlight) {
+            if (auto* behavior = projectile->getComponent<ProjectileBehavior>()) {
+                behavior->reset();
+            }
+            active_.push_back(projectile);
+            activeIndices_.push_back(index);
+        } else {
+            free_.push_back(index);
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "GameObject.h"
+#include "ObjectFactory.h"
+
+class SnapshotWriter;
+class SnapshotReader;
+
+// Fixed-capacity pool of projectile GameObjects (acorns).
+// All objects and their Box2D bodies are created up front by init(); firing
+// hands out a parked object and dead projectiles are parked again, so the
+// steady state does no heap allocation and no body creation/destruction.
+class ProjectilePool {
+public:
+    using CreateFunc = std::function<ObjectPtr()>;
+
+    ProjectilePool() = default;
+
+    // Pre-create `capacity` projectiles (at most 65535). Each is parked
+    // (inactive, physics disabled).
+    void init(size_t capacity, const CreateFunc& create);
+
+    // Take a parked projectile and activate it. Returns nullptr when exhausted.
+    // The caller positions it and sets its velocity.
+    GameObject* acquire();
+
+    // Park every projectile that has been deactivated (off screen or hit)
+    void releaseInactive();
+
+    // Park everything (level start)
+    void releaseAll();
+
+    // Which projectiles are in flight and which are parked (in order). Bodies
+    // are snapshotted separately by PhysicsWorld.
+    void saveState(SnapshotWriter& writer) const;
+    bool restoreState(SnapshotReader& reader);
+    bool readState(SnapshotReader& reader);  // Reads and validates only
+    void applyState();                       // After readState succeeded
+
+    // Projectiles currently in flight
+    const std::vector<GameObject*>& active() const { return active_; }
+
+    // Pool statistics
+    size_t capacity() const { return objects_.size(); }
+    size_t activeCount() const { return active_.size(); }
+    size_t highWaterMark() const { return highWaterMark_; }
+    size_t exhaustedCount() const { return exhaustedCount_; }
+
+private:
+    void park(GameObject* projectile);
+
+    // Projectiles are tracked by their index in objects_, so a snapshot writes
+    // the index lists as they are
+    std::vector<ObjectPtr> objects_;  // Owns every projectile
+    std::vector<uint16_t> free_;
+    std::vector<GameObject*> active_;
+    std::vector<uint16_t> activeIndices_;  // Parallel to active_
+    std::vector<uint16_t> restoreIndices_;  // Read by readState, reused
+    std::vector<uint8_t> restoreSeen_;
+    uint16_t restoreActiveCount_ = 0;
+    size_t highWaterMark_ = 0;
+    size_t exhaustedCount_ = 0;
+};
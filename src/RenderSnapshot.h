@@ -0,0 +1,37 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include "SpriteComponent.h"
+#include "TextureAtlas.h"
+
+// Values shown on the HUD; the HUD layer is redrawn when any of them change
+struct HudState {
+    int nuts, hits, hitsToWin, level;
+    bool gameOver, gameWon;
+    bool operator==(const HudState& other) const {
+        return nuts == other.nuts && hits == other.hits && hitsToWin == other.hitsToWin &&
+               level == other.level && gameOver == other.gameOver && gameWon == other.gameWon;
+    }
+};
+
+// Everything the renderer needs from one simulation tick, copied out so the
+// render side never touches live game objects. Published through a
+// TripleBuffer by the simulation thread.
+struct RenderSnapshot {
+    struct Sprite {
+        TextureHandle texture;                // Resolved through Graphics when drawn
+        SpriteComponent::Placement previous;  // At the previous tick
+        SpriteComponent::Placement current;   // At this tick
+        int layer;
+    };
+
+    bool titleScreen = true;
+    HudState hud = {0, 0, 0, 0, false, false};
+    float branchY = 0.0f;  // Top of the branch under the squirrel
+    std::vector<Sprite> sprites;
+
+    uint64_t tick = 0;                               // Simulation tick that produced it
+    std::chrono::steady_clock::time_point tickTime;  // When it was published
+};
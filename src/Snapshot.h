@@ -0,0 +1,88 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Appends plain values to a binary state buffer (level restart / rollback).
+// The buffer keeps its capacity between snapshots, so taking one every tick
+// does not allocate once it has grown to size.
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(std::vector<uint8_t>& buffer) : buffer_(buffer) {}
+
+    template<typename T>
+    void write(const T& value) {
+        writeArray(&value, 1);
+    }
+
+    template<typename T>
+    void writeArray(const T* values, size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshot values must be trivially copyable");
+        size_t offset = buffer_.size();
+        buffer_.resize(offset + sizeof(T) * count);
+        if (count > 0) {
+            std::memcpy(buffer_.data() + offset, values, sizeof(T) * count);
+        }
+    }
+
+    void writeString(const std::string& text) {  // Length-prefixed
+        write(static_cast<uint32_t>(text.size()));
+        writeArray(text.data(), text.size());
+    }
+
+private:
+    std::vector<uint8_t>& buffer_;
+};
+
+// Reads values back in the order they were written. Any read past the end
+// fails and leaves the reader failed, so callers can check once at the end.
+class SnapshotReader {
+public:
+    explicit SnapshotReader(const std::vector<uint8_t>& buffer)
+        : data_(buffer.data()), end_(buffer.data() + buffer.size()) {}
+    SnapshotReader(const uint8_t* data, size_t size)  // e.g. a memory-mapped archive entry
+        : data_(data), end_(data + size) {}
+
+    template<typename T>
+    bool read(T& value) {
+        return readArray(&value, 1);
+    }
+
+    template<typename T>
+    bool readArray(T* values, size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshot values must be trivially copyable");
+        size_t bytes = sizeof(T) * count;
+        if (failed_ || static_cast<size_t>(end_ - data_) < bytes) {
+            failed_ = true;
+            return false;
+        }
+        if (count > 0) {
+            std::memcpy(values, data_, bytes);
+        }
+        data_ += bytes;
+        return true;
+    }
+
+    bool readString(std::string& text) {
+        uint32_t length = 0;
+        if (!read(length) || static_cast<size_t>(end_ - data_) < length) {
+            failed_ = true;
+            return false;
+        }
+        text.assign(reinterpret_cast<const char*>(data_), length);
+        data_ += length;
+        return true;
+    }
+
+    bool ok() const { return !failed_; }
+    bool atEnd() const { return data_ == end_; }
+    size_t remaining() const { return static_cast<size_t>(end_ - data_); }
+
+private:
+    const uint8_t* data_;
+    const uint8_t* end_;
+    bool failed_ = false;
+};
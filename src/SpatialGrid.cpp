@@ -0,0 +1,104 @@
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+
+// Keep the grid bounded even if something is flung very far away
+static constexpr int MAX_CELLS_PER_AXIS = 256;
+
+void SpatialGrid::clear() {
+    items_.clear();
+    columns_ = 0;
+    rows_ = 0;
+}
+
+void SpatialGrid::insert(uint32_t id, const Aabb& box) {
+    items_.push_back({id, box});
+}
+
+int SpatialGrid::cellX(float x) const {
+    int cell = static_cast<int>(std::floor((x - originX_) / cellSize_));
+    return std::clamp(cell, 0, columns_ - 1);
+}
+
+int SpatialGrid::cellY(float y) const {
+    int cell = static_cast<int>(std::floor((y - originY_) / cellSize_));
+    return std::clamp(cell, 0, rows_ - 1);
+}
+
+void SpatialGrid::build() {
+    if (items_.empty()) return;
+
+    // Grid extent = union of all boxes
+    Aabb bounds = items_[0].box;
+    for (const Item& item : items_) {
+        bounds.minX = std::min(bounds.minX, item.box.minX);
+        bounds.minY = std::min(bounds.minY, item.box.minY);
+        bounds.maxX = std::max(bounds.maxX, item.box.maxX);
+        bounds.maxY = std::max(bounds.maxY, item.box.maxY);
+    }
+    bounds_ = bounds;
+    originX_ = bounds.minX;
+    originY_ = bounds.minY;
+    columns_ = std::clamp(static_cast<int>((bounds.maxX - bounds.minX) / cellSize_) + 1, 1, MAX_CELLS_PER_AXIS);
+    rows_ = std::clamp(static_cast<int>((bounds.maxY - bounds.minY) / cellSize_) + 1, 1, MAX_CELLS_PER_AXIS);
+
+    // Counting sort of item references into cells: count, prefix sum, fill
+    size_t cellCount = static_cast<size_t>(columns_) * rows_;
+    cellStart_.assign(cellCount + 1, 0);
+    for (const Item& item : items_) {
+        int x0 = cellX(item.box.minX), x1 = cellX(item.box.maxX);
+        int y0 = cellY(item.box.minY), y1 = cellY(item.box.maxY);
+        for (int y = y0; y <= y1; y++) {
+            for (int x = x0; x <= x1; x++) {
+                cellStart_[y * columns_ + x + 1]++;
+            }
+        }
+    }
+    for (size_t c = 0; c < cellCount; c++) {
+        cellStart_[c + 1] += cellStart_[c];
+    }
+
+    cellItems_.resize(cellStart_[cellCount]);
+    cellCursor_.assign(cellStart_.begin(), cellStart_.end() - 1);
+    for (uint32_t i = 0; i < items_.size(); i++) {
+        const Aabb& box = items_[i].box;
+        int x0 = cellX(box.minX), x1 = cellX(box.maxX);
+        int y0 = cellY(box.minY), y1 = cellY(box.maxY);
+        for (int y = y0; y <= y1; y++) {
+            for (int x = x0; x <= x1; x++) {
+                cellItems_[cellCursor_[y * columns_ + x]++] = i;
+            }
+        }
+    }
+
+    queryStamp_.assign(items_.size(), 0);
+    queryId_ = 0;
+}
+
+void SpatialGrid::query(const Aabb& area, std::vector<uint32_t>& out) {
+    if (items_.empty() || columns_ == 0) return;
+
+    // Reject areas entirely outside every box before clamping into the grid
+    // (edge cells also hold anything beyond MAX_CELLS_PER_AXIS)
+    if (!bounds_.overlaps(area)) return;
+
+    queryId_++;
+    size_t first = out.size();
+    int x0 = cellX(area.minX), x1 = cellX(area.maxX);
+    int y0 = cellY(area.minY), y1 = cellY(area.maxY);
+    for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
+            int cell = y * columns_ + x;
+            for (uint32_t k = cellStart_[cell]; k < cellStart_[cell + 1]; k++) {
+                uint32_t index = cellItems_[k];
+                // Items spanning several cells are seen more than once
+                if (queryStamp_[index] == queryId_) continue;
+                queryStamp_[index] = queryId_;
+                if (items_[index].box.overlaps(area)) {
+                    out.push_back(items_[index].id);
+                }
+            }
+        }
+    }
+    std::sort(out.begin() + first, out.end());
+}
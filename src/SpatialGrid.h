@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Axis-aligned bounding box in world units
+struct Aabb {
+    float minX, minY, maxX, maxY;
+
+    bool overlaps(const Aabb& other) const {
+        return minX <= other.maxX && maxX >= other.minX &&
+               minY <= other.maxY && maxY >= other.minY;
+    }
+};
+
+// Uniform grid over the boxes inserted since the last clear().
+// Usage per frame: clear(), insert() every item, build(), then query().
+// The grid covers exactly the inserted boxes, so it works for any world size;
+// cells are stored flat (counting sort), and all buffers are reused, so a
+// rebuild does not allocate in steady state.
+class SpatialGrid {
+public:
+    explicit SpatialGrid(float cellSize = 128.0f) : cellSize_(cellSize) {}
+
+    void clear();
+    void insert(uint32_t id, const Aabb& box);
+    void build();
+
+    // Append the ids of every item whose box overlaps `area` (each id once,
+    // in ascending order)
+    void query(const Aabb& area, std::vector<uint32_t>& out);
+
+    size_t size() const { return items_.size(); }
+
+private:
+    struct Item {
+        uint32_t id;
+        Aabb box;
+    };
+
+    int cellX(float x) const;
+    int cellY(float y) const;
+
+    float cellSize_;
+    std::vector<Item> items_;
+    Aabb bounds_ = {0.0f, 0.0f, 0.0f, 0.0f};  // Union of all boxes
+    float originX_ = 0.0f, originY_ = 0.0f;
+    int columns_ = 0, rows_ = 0;
+    std::vector<uint32_t> cellStart_;   // columns*rows+1 offsets into cellItems_
+    std::vector<uint32_t> cellItems_;   // Item indices, grouped by cell
+    std::vector<uint32_t> cellCursor_;  // Fill position per cell during build()
+    std::vector<uint32_t> queryStamp_;  // Per item: last query that reported it
+    uint32_t queryId_ = 0;
+};
@@ -0,0 +1,83 @@
+#include "SpriteBatch.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+void SpriteBatch::add(const TextureRegion& region, const SDL_FRect& dest, float rotation,
+                      int layer, SDL_Color color) {
+    if (!region.texture) return;
+
+    Quad quad;
+    quad.layer = layer;
+    quad.texture = region.texture;
+
+    // Corners relative to the centre, in the order TL, TR, BR, BL
+    float halfW = dest.w * 0.5f;
+    float halfH = dest.h * 0.5f;
+    float cx = dest.x + halfW;
+    float cy = dest.y + halfH;
+    const float corners[4][2] = {{-halfW, -halfH}, {halfW, -halfH}, {halfW, halfH}, {-halfW, halfH}};
+    const float uvs[4][2] = {{region.u0, region.v0}, {region.u1, region.v0},
+                             {region.u1, region.v1}, {region.u0, region.v1}};
+
+    // Same rotation as SDL_RenderCopyEx (y points down, so positive is clockwise)
+    float c = 1.0f;
+    float s = 0.0f;
+    if (rotation != 0.0f) {
+        c = std::cos(rotation);
+        s = std::sin(rotation);
+    }
+    for (int i = 0; i < 4; i++) {
+        float x = corners[i][0];
+        float y = corners[i][1];
+        quad.vertices[i].position = {cx + x * c - y * s, cy + x * s + y * c};
+        quad.vertices[i].color = color;
+        quad.vertices[i].tex_coord = {uvs[i][0], uvs[i][1]};
+    }
+    quads_.push_back(quad);
+}
+
+int SpriteBatch::flush(SDL_Renderer* renderer) {
+    if (quads_.empty()) return 0;
+
+    // Sort indices rather than the quads themselves
+    order_.resize(quads_.size());
+    for (uint32_t i = 0; i < order_.size(); i++) order_[i] = i;
+    std::stable_sort(order_.begin(), order_.end(), [this](uint32_t a, uint32_t b) {
+        const Quad& qa = quads_[a];
+        const Quad& qb = quads_[b];
+        if (qa.layer != qb.layer) return qa.layer < qb.layer;
+        return std::less<SDL_Texture*>()(qa.texture, qb.texture);
+    });
+
+    int drawCalls = 0;
+    size_t runStart = 0;
+    while (runStart < order_.size()) {
+        // Extend the run while layer and texture stay the same
+        const Quad& first = quads_[order_[runStart]];
+        size_t runEnd = runStart + 1;
+        while (runEnd < order_.size() &&
+               quads_[order_[runEnd]].layer == first.layer &&
+               quads_[order_[runEnd]].texture == first.texture) {
+            runEnd++;
+        }
+
+        vertices_.clear();
+        indices_.clear();
+        for (size_t i = runStart; i < runEnd; i++) {
+            const Quad& quad = quads_[order_[i]];
+            int base = static_cast<int>(vertices_.size());
+            vertices_.insert(vertices_.end(), quad.vertices, quad.vertices + 4);
+            indices_.insert(indices_.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+        }
+
+        SDL_RenderGeometry(renderer, first.texture,
+                           vertices_.data(), static_cast<int>(vertices_.size()),
+                           indices_.data(), static_cast<int>(indices_.size()));
+        drawCalls++;
+        runStart = runEnd;
+    }
+
+    quads_.clear();
+    return drawCalls;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <SDL.h>
+#include <cstdint>
+#include <vector>
+#include "TextureAtlas.h"
+
+// Collects a frame's sprite quads and submits them with SDL_RenderGeometry.
+// Rotation is applied on the CPU, so rotated and axis-aligned sprites batch
+// together. flush() orders quads by layer, then texture (stable within a
+// layer/texture run), and issues one draw call per run.
+class SpriteBatch {
+public:
+    SpriteBatch() = default;
+
+    // Queue `region` drawn into `dest`, rotated by `rotation` radians
+    // (clockwise on screen) around the centre of `dest`
+    void add(const TextureRegion& region, const SDL_FRect& dest, float rotation = 0.0f,
+             int layer = 0, SDL_Color color = {255, 255, 255, 255});
+
+    // Draw everything queued. Returns the number of draw calls issued.
+    int flush(SDL_Renderer* renderer);
+
+    size_t size() const { return quads_.size(); }
+    bool empty() const { return quads_.empty(); }
+
+private:
+    struct Quad {
+        int layer;
+        SDL_Texture* texture;
+        SDL_Vertex vertices[4];
+    };
+
+    // Reused every frame
+    std::vector<Quad> quads_;
+    std::vector<uint32_t> order_;
+    std::vector<SDL_Vertex> vertices_;
+    std::vector<int> indices_;
+};
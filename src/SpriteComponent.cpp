@@ -2,13 +2,70 @@
 #include "GameObject.h"
 #include "BodyComponent.h"
 #include "View.h"
+#include "SpriteBatch.h"
+#include "SpatialGrid.h"
+#include <cmath>
 
-SpriteComponent::SpriteComponent(const std::string& textureName, SDL_Renderer* renderer)
-    : textureName_(textureName), renderer_(renderer) {
+SpriteComponent::SpriteComponent(TextureHandle texture, const TextureAtlas* textures, SDL_Renderer* renderer)
+    : texture_(texture), textures_(textures), renderer_(renderer) {
+}
+
+bool SpriteComponent::getPlacement(float alpha, Placement& placement) const {
+    if (!texture_.isValid()) return false;
+    
+    auto* body = owner_->getComponent<BodyComponent>();
+    if (!body) return false;
+    
+    // Blend between the previous and current simulation tick
+    placement.halfWidth = body->getWidth() * 0.5f;
+    placement.halfHeight = body->getHeight() * 0.5f;
+    placement.centerX = body->getInterpolatedX(alpha) + placement.halfWidth;
+    placement.centerY = body->getInterpolatedY(alpha) + placement.halfHeight;
+    placement.rotation = body->getInterpolatedRotation(alpha);
+    return true;
+}
+
+SpriteComponent::Placement SpriteComponent::interpolate(const Placement& from, const Placement& to, float alpha) {
+    return {
+        from.centerX + (to.centerX - from.centerX) * alpha,
+        from.centerY + (to.centerY - from.centerY) * alpha,
+        from.halfWidth + (to.halfWidth - from.halfWidth) * alpha,
+        from.halfHeight + (to.halfHeight - from.halfHeight) * alpha,
+        from.rotation + (to.rotation - from.rotation) * alpha
+    };
+}
+
+Aabb SpriteComponent::getWorldBounds(const Placement& placement) {
+    // A rotated box needs a wider AABB
+    float extentX = placement.halfWidth;
+    float extentY = placement.halfHeight;
+    if (placement.rotation != 0.0f) {
+        float c = std::abs(std::cos(placement.rotation));
+        float s = std::abs(std::sin(placement.rotation));
+        extentX = c * placement.halfWidth + s * placement.halfHeight;
+        extentY = s * placement.halfWidth + c * placement.halfHeight;
+    }
+    return {placement.centerX - extentX, placement.centerY - extentY,
+            placement.centerX + extentX, placement.centerY + extentY};
+}
+
+void SpriteComponent::submit(SpriteBatch& batch, const TextureRegion& region, int layer, const Placement& world,
+                             float screenX, float screenY, const View& view) {
+    // Zoom scales the quad about its (already transformed) centre; kept in
+    // floats so slow or zoomed motion stays subpixel-smooth
+    float halfW = world.halfWidth * view.getScale();
+    float halfH = world.halfHeight * view.getScale();
+    SDL_FRect destRect = {screenX - halfW, screenY - halfH, 2.0f * halfW, 2.0f * halfH};
+    
+    // BOX2D-SDL SYNC: Render sprite with physics rotation (radians, makes spinning
+    // acorns visible) relative to the camera; the batch rotates the quad on the CPU
+    batch.add(region, destRect, world.rotation - view.getRotation(), layer);
 }
 
 void SpriteComponent::render() {
-    if (!texture_ || !renderer_) return;
+    if (!textures_ || !renderer_) return;
+    const TextureRegion& region = textures_->getRegion(texture_);
+    if (!region.texture) return;
     
     auto* body = owner_->getComponent<BodyComponent>();
     if (!body) return;
@@ -20,35 +77,19 @@ void SpriteComponent::render() {
         static_cast<int>(body->getHeight())
     };
     
-    SDL_RenderCopy(renderer_, texture_, nullptr, &destRect);
+    SDL_RenderCopy(renderer_, region.texture, &region.rect, &destRect);
 }
 
-void SpriteComponent::render(const View* view) {
-    if (!texture_ || !renderer_) return;
-    
-    auto* body = owner_->getComponent<BodyComponent>();
-    if (!body) return;
+void SpriteComponent::render(SpriteBatch& batch, const View* view, float alpha) {
+    Placement placement;
+    if (!textures_ || !getPlacement(alpha, placement)) return;
+    const TextureRegion& region = textures_->getRegion(texture_);
     
-    // Transform world coordinates to screen coordinates using the view
-    int screenX, screenY;
     if (view) {
-        view->worldToScreen(body->getX(), body->getY(), screenX, screenY);
+        float screenX, screenY;
+        view->worldToScreen(placement.centerX, placement.centerY, screenX, screenY);
+        submit(batch, region, layer_, placement, screenX, screenY, *view);
     } else {
-        screenX = static_cast<int>(body->getX());
-        screenY = static_cast<int>(body->getY());
+        submit(batch, region, layer_, placement, placement.centerX, placement.centerY, View());
     }
-    
-    SDL_Rect destRect = {
-        screenX,
-        screenY,
-        static_cast<int>(body->getWidth()),
-        static_cast<int>(body->getHeight())
-    };
-    
-    // BOX2D-SDL SYNC: Render sprite with physics rotation
-    // Convert rotation from radians (Box2D) to degrees (SDL)
-    double angleDegrees = body->getRotation() * (180.0 / 3.14159265359);
-    
-    // Use SDL_RenderCopyEx to render with rotation (makes spinning acorns visible)
-    SDL_RenderCopyEx(renderer_, texture_, nullptr, &destRect, angleDegrees, nullptr, SDL_FLIP_NONE);
 }
@@ -1,22 +1,56 @@
 #pragma once
 #include "Component.h"
+#include "TextureAtlas.h"
 #include <SDL.h>
-#include <string>
 
 class View;
+class SpriteBatch;
+struct Aabb;
 
 class SpriteComponent : public Component {
 public:
-    SpriteComponent(const std::string& textureName, SDL_Renderer* renderer);
+    // `textures` is only needed by the render() paths below; the game draws
+    // from snapshots, resolving the handle through Graphics
+    SpriteComponent(TextureHandle texture, const TextureAtlas* textures, SDL_Renderer* renderer);
     
-    std::string getType() const override { return "SpriteComponent"; }
+    static constexpr ComponentType TYPE = ComponentType::Sprite;
+    const char* getType() const override { return "SpriteComponent"; }
     
-    void setTexture(SDL_Texture* texture) { texture_ = texture; }
-    void render() override;  // Legacy render without view
-    void render(const View* view);  // Render with view transform
+    void setTexture(TextureHandle texture) { texture_ = texture; }
+    TextureHandle getTexture() const { return texture_; }
+    void setLayer(int layer) { layer_ = layer; }
+    int getLayer() const { return layer_; }
+    
+    // Where the sprite is drawn at the interpolated tick. The quad rotates
+    // about its centre, so placement is centre-based.
+    struct Placement {
+        float centerX, centerY;
+        float halfWidth, halfHeight;
+        float rotation;  // Radians
+    };
+    
+    // World-space placement; returns false if the sprite has nothing to draw
+    bool getPlacement(float alpha, Placement& placement) const;
+    
+    // Blend two placements (rotation must already be unwrapped, as
+    // getPlacement(1) is relative to getPlacement(0))
+    static Placement interpolate(const Placement& from, const Placement& to, float alpha);
+    
+    // Box around a (rotated) placement, for culling
+    static Aabb getWorldBounds(const Placement& placement);
+    
+    // Queue `region` at a screen-space centre already transformed by `view`
+    // (the view's scale and rotation are applied to the size and angle)
+    static void submit(SpriteBatch& batch, const TextureRegion& region, int layer, const Placement& world,
+                       float screenX, float screenY, const View& view);
+    
+    void render() override;  // Legacy immediate render without view
+    // Queue into the sprite batch with view transform, interpolated by alpha
+    void render(SpriteBatch& batch, const View* view, float alpha = 1.0f);
 
 private:
-    SDL_Texture* texture_ = nullptr;
+    TextureHandle texture_;
+    int layer_ = 0;
+    const TextureAtlas* textures_ = nullptr;
     SDL_Renderer* renderer_ = nullptr;
-    std::string textureName_;
 };
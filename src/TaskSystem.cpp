@@ -0,0 +1,169 @@
+#include "TaskSystem.h"
+#include <algorithm>
+
+TaskSystem::TaskSystem(int workerCount) {
+    if (workerCount <= 0) {
+        workerCount = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    workerCount_ = std::max(workerCount, 1);
+
+    for (int i = 0; i < workerCount_; i++) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+
+    // Worker 0 is whichever thread waits on a task; the rest get their own thread
+    for (int i = 1; i < workerCount_; i++) {
+        threads_.emplace_back(&TaskSystem::workerLoop, this, static_cast<uint32_t>(i));
+    }
+}
+
+TaskSystem::~TaskSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void* TaskSystem::parallelFor(RangeFunc* func, int itemCount, int minRange, void* context) {
+    minRange = std::max(minRange, 1);
+
+    // Nobody to hand the work to (or no free task slot): run inline. A range
+    // too small to split is still queued as one job, since Box2D's solver
+    // queues one single-item task per worker and expects them to run
+    // concurrently with the caller.
+    Task* task = nullptr;
+    if (workerCount_ > 1 && itemCount > 0) {
+        task = allocateTask();
+    }
+    if (!task) {
+        func(0, itemCount, 0, context);
+        return nullptr;
+    }
+
+    // Over-split a little so stealing can balance uneven ranges
+    int maxJobs = workerCount_ * 2;
+    int rangeSize = std::max(minRange, (itemCount + maxJobs - 1) / maxJobs);
+    int jobCount = (itemCount + rangeSize - 1) / rangeSize;
+
+    task->func = func;
+    task->context = context;
+    task->remaining.store(jobCount, std::memory_order_relaxed);
+
+    // Deal the jobs to the owned threads; the caller is usually busy until it
+    // waits, and steals from them then
+    for (int start = 0; start < itemCount; start += rangeSize) {
+        Job job{task, start, std::min(start + rangeSize, itemCount)};
+        uint32_t target = 1 + nextWorker_.fetch_add(1, std::memory_order_relaxed) % (workerCount_ - 1);
+        push(target, job);
+    }
+
+    pendingJobs_.fetch_add(jobCount, std::memory_order_release);
+    {
+        // Taking the lock orders the wake-up after sleepers checked pendingJobs_
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    wake_.notify_all();
+
+    return task;
+}
+
+void TaskSystem::wait(void* handle) {
+    if (!handle) return;
+    Task* task = static_cast<Task*>(handle);
+
+    while (task->remaining.load(std::memory_order_acquire) > 0) {
+        Job job;
+        if (popOrSteal(0, job)) {
+            execute(job, 0);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    task->inUse.store(false, std::memory_order_release);
+}
+
+bool TaskSystem::tryWait(void* handle) {
+    if (!handle) return true;
+    Task* task = static_cast<Task*>(handle);
+    if (task->remaining.load(std::memory_order_acquire) > 0) return false;
+    task->inUse.store(false, std::memory_order_release);
+    return true;
+}
+
+void* TaskSystem::enqueueBox2DTask(RangeFunc* task, int itemCount, int minRange, void* taskContext, void* userContext) {
+    return static_cast<TaskSystem*>(userContext)->parallelFor(task, itemCount, minRange, taskContext);
+}
+
+void TaskSystem::finishBox2DTask(void* userTask, void* userContext) {
+    static_cast<TaskSystem*>(userContext)->wait(userTask);
+}
+
+TaskSystem::Task* TaskSystem::allocateTask() {
+    for (auto& task : tasks_) {
+        bool expected = false;
+        if (task.inUse.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            return &task;
+        }
+    }
+    return nullptr;  // All slots busy: caller runs the work inline
+}
+
+void TaskSystem::push(uint32_t workerIndex, const Job& job) {
+    Worker& worker = *workers_[workerIndex];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.jobs.push_back(job);
+}
+
+bool TaskSystem::popOrSteal(uint32_t workerIndex, Job& job) {
+    // Own deque first, newest job (still warm in cache)
+    {
+        Worker& own = *workers_[workerIndex];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = own.jobs.back();
+            own.jobs.pop_back();
+            pendingJobs_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // Then steal the oldest job from another worker
+    for (int i = 1; i < workerCount_; i++) {
+        Worker& victim = *workers_[(workerIndex + i) % workerCount_];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = victim.jobs.front();
+            victim.jobs.pop_front();
+            pendingJobs_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void TaskSystem::execute(const Job& job, uint32_t workerIndex) {
+    job.task->func(job.start, job.end, workerIndex, job.task->context);
+    job.task->remaining.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void TaskSystem::workerLoop(uint32_t workerIndex) {
+    for (;;) {
+        Job job;
+        if (popOrSteal(workerIndex, job)) {
+            execute(job, workerIndex);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        wake_.wait(lock, [this] {
+            return stopping_ || pendingJobs_.load(std::memory_order_acquire) > 0;
+        });
+        if (stopping_) return;
+    }
+}
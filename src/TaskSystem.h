@@ -0,0 +1,88 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool for parallel-for style jobs.
+//
+// Worker 0 is the thread that waits on a task (usually the main thread); it
+// helps execute jobs while waiting. Workers 1..N-1 are owned threads. Each
+// worker has its own job deque: owners pop from the back, idle workers steal
+// from the front of someone else's deque.
+//
+// The range callback has the same shape as Box2D's b2TaskCallback so the
+// system can be plugged straight into b2WorldDef (see PhysicsWorld).
+class TaskSystem {
+public:
+    using RangeFunc = void(int startIndex, int endIndex, uint32_t workerIndex, void* context);
+
+    // workerCount includes the calling thread; 0 picks the hardware thread count
+    explicit TaskSystem(int workerCount = 0);
+    ~TaskSystem();
+
+    TaskSystem(const TaskSystem&) = delete;
+    TaskSystem& operator=(const TaskSystem&) = delete;
+
+    int getWorkerCount() const { return workerCount_; }
+
+    // Split [0, itemCount) into ranges of at least minRange items and queue them
+    // (a single range is queued too). Returns a task handle for wait(), or
+    // nullptr if the work already ran inline (one worker, or no free task slot).
+    void* parallelFor(RangeFunc* func, int itemCount, int minRange, void* context);
+
+    // Block until a task finishes, executing queued jobs meanwhile (as worker 0)
+    void wait(void* task);
+
+    // Non-blocking wait(): true (and the handle is released) once the task has
+    // finished. For background work polled from a thread that never helps;
+    // needs at least one owned worker thread to make progress.
+    bool tryWait(void* task);
+
+    // Box2D task hooks (userContext is the TaskSystem)
+    static void* enqueueBox2DTask(RangeFunc* task, int itemCount, int minRange, void* taskContext, void* userContext);
+    static void finishBox2DTask(void* userTask, void* userContext);
+
+private:
+    struct Task {
+        RangeFunc* func = nullptr;
+        void* context = nullptr;
+        std::atomic<int> remaining{0};
+        std::atomic<bool> inUse{false};
+    };
+
+    struct Job {
+        Task* task;
+        int start;
+        int end;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    static constexpr int MAX_TASKS = 128;
+
+    Task* allocateTask();
+    void push(uint32_t workerIndex, const Job& job);
+    bool popOrSteal(uint32_t workerIndex, Job& job);
+    void execute(const Job& job, uint32_t workerIndex);
+    void workerLoop(uint32_t workerIndex);
+
+    int workerCount_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    Task tasks_[MAX_TASKS];
+    std::atomic<uint32_t> nextWorker_{0};
+
+    // Idle workers sleep here until jobs are queued
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+    std::atomic<int> pendingJobs_{0};
+    bool stopping_ = false;
+};
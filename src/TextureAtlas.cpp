@@ -0,0 +1,200 @@
+#include "TextureAtlas.h"
+#include <algorithm>
+#include <iostream>
+
+TextureAtlas::TextureAtlas()
+    : regions_(1) {
+}
+
+TextureAtlas::~TextureAtlas() {
+    destroy();
+}
+
+void TextureAtlas::add(const std::string& name, SDL_Surface* surface) {
+    if (!surface) return;
+    registerName(name);
+    pending_.emplace_back(name, surface);
+}
+
+TextureHandle TextureAtlas::registerName(const std::string& name) {
+    auto it = indices_.find(name);
+    if (it != indices_.end()) {
+        return makeHandle(it->second);
+    }
+    if (regions_.size() > TextureHandle::INDEX_MASK) {
+        std::cerr << "TextureAtlas: too many images, " << name << " gets no handle\n";
+        return {};
+    }
+    uint32_t index = static_cast<uint32_t>(regions_.size());
+    regions_.emplace_back();  // Empty until its page is uploaded
+    indices_.emplace(name, index);
+    return makeHandle(index);
+}
+
+bool TextureAtlas::build(SDL_Renderer* renderer, int maxPageSize) {
+    if (pending_.empty()) return true;
+    if (!renderer) return false;
+
+    std::vector<PackedPage> pages;
+    bool ok = pack(maxPageSize, pages);
+    for (PackedPage& page : pages) {
+        SDL_Surface* surface = page.surface;
+        ok = addPage(renderer, surface->pixels, surface->w, surface->h, surface->pitch, page.regions) && ok;
+        SDL_FreeSurface(surface);
+    }
+    return ok;
+}
+
+bool TextureAtlas::pack(int maxPageSize, std::vector<PackedPage>& packedPages) {
+    // Tallest first keeps the shelves tight
+    std::stable_sort(pending_.begin(), pending_.end(), [](const auto& a, const auto& b) {
+        return a.second->h > b.second->h;
+    });
+
+    struct Page {
+        int width = 0, height = 0;             // Used extent
+        int penX = 0, shelfY = 0, shelfH = 0;  // Current shelf
+    };
+    struct Placement {
+        size_t page;
+        int x, y;
+    };
+    std::vector<Page> pages;
+    std::vector<Placement> placements;
+    placements.reserve(pending_.size());
+    size_t openPage = SIZE_MAX;
+
+    for (const auto& [name, surface] : pending_) {
+        int w = surface->w;
+        int h = surface->h;
+
+        if (w > maxPageSize || h > maxPageSize) {
+            // Too big to share: it gets a page of its own
+            pages.push_back({w, h, w, 0, h});
+            placements.push_back({pages.size() - 1, 0, 0});
+            continue;
+        }
+
+        if (openPage != SIZE_MAX) {
+            Page& page = pages[openPage];
+            if (page.penX + w > maxPageSize) {
+                page.shelfY += page.shelfH + PADDING;
+                page.penX = 0;
+                page.shelfH = 0;
+            }
+            if (page.shelfY + h > maxPageSize) {
+                openPage = SIZE_MAX;
+            }
+        }
+        if (openPage == SIZE_MAX) {
+            pages.push_back({});
+            openPage = pages.size() - 1;
+        }
+
+        Page& page = pages[openPage];
+        placements.push_back({openPage, page.penX, page.shelfY});
+        page.penX += w + PADDING;
+        page.shelfH = std::max(page.shelfH, h);
+        page.width = std::max(page.width, page.penX - PADDING);
+        page.height = std::max(page.height, page.shelfY + h);
+    }
+
+    // Compose each page on the CPU
+    bool ok = true;
+    for (size_t p = 0; p < pages.size(); p++) {
+        SDL_Surface* pageSurface = SDL_CreateRGBSurfaceWithFormat(0, pages[p].width, pages[p].height, 32, SDL_PIXELFORMAT_ARGB8888);
+        if (!pageSurface) {
+            std::cerr << "TextureAtlas: failed to create page: " << SDL_GetError() << "\n";
+            ok = false;
+            continue;
+        }
+        SDL_FillRect(pageSurface, nullptr, SDL_MapRGBA(pageSurface->format, 0, 0, 0, 0));
+
+        PackedPage packed;
+        packed.surface = pageSurface;
+        for (size_t i = 0; i < pending_.size(); i++) {
+            if (placements[i].page != p) continue;
+            SDL_Surface* image = pending_[i].second;
+            SDL_Rect dest = {placements[i].x, placements[i].y, image->w, image->h};
+            SDL_SetSurfaceBlendMode(image, SDL_BLENDMODE_NONE);  // Copy alpha as-is
+            SDL_BlitSurface(image, nullptr, pageSurface, &dest);
+            packed.regions.push_back({pending_[i].first, {placements[i].x, placements[i].y, image->w, image->h}});
+        }
+        packedPages.push_back(std::move(packed));
+    }
+
+    for (auto& [name, surface] : pending_) {
+        SDL_FreeSurface(surface);
+    }
+    pending_.clear();
+    return ok;
+}
+
+bool TextureAtlas::addPage(SDL_Renderer* renderer, const void* pixels, int width, int height, int pitch,
+                           const std::vector<PackedRegion>& regions) {
+    SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC,
+                                             width, height);
+    if (!texture || SDL_UpdateTexture(texture, nullptr, pixels, pitch) != 0) {
+        std::cerr << "TextureAtlas: failed to upload page: " << SDL_GetError() << "\n";
+        if (texture) SDL_DestroyTexture(texture);
+        return false;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    // Images are stored at or above their display size, so they are minified
+    // slightly when drawn; linear filtering keeps that smooth
+    SDL_SetTextureScaleMode(texture, SDL_ScaleModeLinear);
+    pages_.push_back(texture);
+    pageBytes_ += static_cast<size_t>(width) * height * 4;
+
+    float invW = 1.0f / width;
+    float invH = 1.0f / height;
+    for (const PackedRegion& packed : regions) {
+        TextureHandle handle = registerName(packed.name);
+        if (!handle.isValid()) continue;
+        TextureRegion& region = regions_[handle.index()];
+        region.texture = texture;
+        region.rect = packed.rect;
+        region.u0 = region.rect.x * invW;
+        region.v0 = region.rect.y * invH;
+        region.u1 = (region.rect.x + region.rect.w) * invW;
+        region.v1 = (region.rect.y + region.rect.h) * invH;
+    }
+    std::cout << "Texture atlas page " << pages_.size() - 1 << ": " << width << "x" << height << "\n";
+    return true;
+}
+
+TextureHandle TextureAtlas::find(const std::string& name) const {
+    auto it = indices_.find(name);
+    return it != indices_.end() ? makeHandle(it->second) : TextureHandle();
+}
+
+bool TextureAtlas::isCurrent(TextureHandle handle) const {
+    if (!handle.isValid()) return true;  // Always allowed: draws nothing
+    return handle.generation() == generation_ && handle.index() > 0 && handle.index() < regions_.size();
+}
+
+const TextureRegion& TextureAtlas::rejectHandle(TextureHandle handle) const {
+    if (!rejectedHandle_) {  // Once, not every frame
+        std::cerr << "TextureAtlas: stale or foreign texture handle 0x" << std::hex << handle.value << std::dec
+                  << " (index " << handle.index() << ", generation " << handle.generation()
+                  << ", atlas generation " << generation_ << ")\n";
+        rejectedHandle_ = true;
+    }
+    return regions_[0];
+}
+
+void TextureAtlas::destroy() {
+    for (SDL_Texture* page : pages_) {
+        SDL_DestroyTexture(page);
+    }
+    pages_.clear();
+    pageBytes_ = 0;
+    for (auto& [name, surface] : pending_) {
+        SDL_FreeSurface(surface);
+    }
+    pending_.clear();
+    regions_.assign(1, TextureRegion());
+    indices_.clear();
+    generation_ = generation_ % 255 + 1;  // 8 bits, skipping 0
+    rejectedHandle_ = false;
+}
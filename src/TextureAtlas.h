@@ -0,0 +1,107 @@
+#pragma once
+
+#include <SDL.h>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// A named image inside an atlas page
+struct TextureRegion {
+    SDL_Texture* texture = nullptr;  // Atlas page the image was packed into
+    SDL_Rect rect = {0, 0, 0, 0};    // Pixel rectangle within the page
+    float u0 = 0.0f, v0 = 0.0f;      // Normalized texture coordinates
+    float u1 = 1.0f, v1 = 1.0f;
+};
+
+// Compact reference to an atlas image, looked up by name once at load time so
+// nothing is resolved by string per frame. The low 24 bits index the atlas's
+// region table; the high 8 bits are the atlas generation, which lets debug
+// builds reject handles kept across destroy(). A default handle draws nothing.
+struct TextureHandle {
+    static constexpr uint32_t INDEX_BITS = 24;
+    static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+
+    uint32_t value = 0;
+
+    uint32_t index() const { return value & INDEX_MASK; }
+    uint32_t generation() const { return value >> INDEX_BITS; }
+    bool isValid() const { return value != 0; }
+    bool operator==(TextureHandle other) const { return value == other.value; }
+    bool operator!=(TextureHandle other) const { return value != other.value; }
+};
+
+// Packs loaded images into as few textures as possible so sprites drawn from
+// different images can share one draw call. Images are queued with add() and
+// uploaded together by build(). Every image name gets a handle when it is
+// first queued or uploaded; the handle stays the same for the lifetime of the
+// atlas and maps to the image's region once its page is uploaded.
+class TextureAtlas {
+public:
+    TextureAtlas();
+    ~TextureAtlas();
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    // Queue an image for the next build(). Takes ownership of the surface.
+    void add(const std::string& name, SDL_Surface* surface);
+
+    // Shelf-pack every queued image into pages of at most maxPageSize and
+    // upload them. Images larger than a page get a page of their own.
+    bool build(SDL_Renderer* renderer, int maxPageSize);
+
+    // The two halves of build(), for packing offline (tools/asset_packer)
+    // and uploading pre-packed pages at startup
+    struct PackedRegion {
+        std::string name;
+        SDL_Rect rect;
+    };
+    struct PackedPage {
+        SDL_Surface* surface = nullptr;  // ARGB8888; the caller frees it
+        std::vector<PackedRegion> regions;
+    };
+    // Compose every queued image into pages on the CPU; needs no renderer
+    bool pack(int maxPageSize, std::vector<PackedPage>& pages);
+    // Upload one ARGB8888 page straight from its pixels (which may be
+    // memory-mapped) and register its regions
+    bool addPage(SDL_Renderer* renderer, const void* pixels, int width, int height, int pitch,
+                 const std::vector<PackedRegion>& regions);
+
+    // Name lookup, for load and setup time; an invalid handle if unknown
+    TextureHandle find(const std::string& name) const;
+
+    // Per-frame lookup: an array index. The invalid handle, and in any build
+    // an index past the table, map to the empty region, which the sprite
+    // batch skips. Debug builds also check that the handle came from this
+    // atlas since its last destroy(), and log the first one that did not.
+    const TextureRegion& getRegion(TextureHandle handle) const {
+#ifndef NDEBUG
+        if (!isCurrent(handle)) return rejectHandle(handle);
+#endif
+        uint32_t index = handle.index();
+        return index < regions_.size() ? regions_[index] : regions_[0];
+    }
+    bool isCurrent(TextureHandle handle) const;
+
+    void destroy();  // Invalidates every handle handed out so far
+
+    size_t getPageCount() const { return pages_.size(); }
+    size_t getRegionCount() const { return regions_.size() - 1; }
+    size_t getPageBytes() const { return pageBytes_; }  // Texture memory of all pages
+
+private:
+    static constexpr int PADDING = 2;  // Transparent gap so linear filtering never bleeds between images
+
+    TextureHandle registerName(const std::string& name);
+    TextureHandle makeHandle(uint32_t index) const { return {index | (generation_ << TextureHandle::INDEX_BITS)}; }
+    const TextureRegion& rejectHandle(TextureHandle handle) const;
+
+    std::vector<TextureRegion> regions_;  // By handle index; [0] is the empty region
+    std::unordered_map<std::string, uint32_t> indices_;
+    uint32_t generation_ = 1;  // Never 0, so the invalid handle is never current
+    mutable bool rejectedHandle_ = false;
+    std::vector<std::pair<std::string, SDL_Surface*>> pending_;
+    std::vector<SDL_Texture*> pages_;
+    size_t pageBytes_ = 0;
+};
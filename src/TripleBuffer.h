@@ -0,0 +1,42 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single-producer / single-consumer triple buffer.
+// The producer fills writeBuffer() and publish()es it; the consumer calls
+// acquire() and reads readBuffer(). Neither side ever waits for the other:
+// the producer always has a free buffer, and the consumer always sees the
+// most recently published one (older unread ones are simply overwritten).
+// Buffers are reused in rotation, so T's allocations (e.g. vector capacity)
+// are kept.
+template <typename T>
+class TripleBuffer {
+public:
+    // Producer side
+    T& writeBuffer() { return buffers_[back_]; }
+    void publish() {
+        // Hand the filled buffer over and take whichever one was in the middle
+        uint8_t previous = middle_.exchange(static_cast<uint8_t>(back_ | FRESH), std::memory_order_acq_rel);
+        back_ = previous & INDEX_MASK;
+    }
+
+    // Consumer side. Returns true if a newer buffer was published since the
+    // last acquire(); readBuffer() is unchanged otherwise.
+    bool acquire() {
+        if (!(middle_.load(std::memory_order_relaxed) & FRESH)) return false;
+        uint8_t previous = middle_.exchange(front_, std::memory_order_acq_rel);
+        front_ = previous & INDEX_MASK;
+        return true;
+    }
+    const T& readBuffer() const { return buffers_[front_]; }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t FRESH = 0x4;  // Middle buffer has not been acquired yet
+
+    T buffers_[3];
+    uint8_t back_ = 0;                 // Owned by the producer
+    std::atomic<uint8_t> middle_{1};   // Shared hand-over slot
+    uint8_t front_ = 2;                // Owned by the consumer
+};
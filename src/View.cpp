@@ -2,32 +2,94 @@
 #include <algorithm>
 #include <cmath>
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define VIEW_USE_SSE
+#endif
+
 View::View(float x, float y, float width, float height)
     : centerX_(x), centerY_(y), width_(width), height_(height) {
+    updateTransform();
 }
 
-void View::worldToScreen(float worldX, float worldY, int& screenX, int& screenY) const {
-    // Translate world coordinates relative to view center
-    float relativeX = worldX - centerX_;
-    float relativeY = worldY - centerY_;
+void View::updateTransform() {
+    // Translate to the view center, rotate by -rotation, scale, then move the
+    // origin to the middle of the screen. cos/sin are evaluated here only.
+    float cosAngle = std::cos(rotation_);
+    float sinAngle = std::sin(rotation_);
+    Transform& m = worldToScreen_;
+    m.a = scale_ * cosAngle;
+    m.b = -scale_ * sinAngle;
+    m.c = scale_ * sinAngle;
+    m.d = scale_ * cosAngle;
+    m.tx = width_ / 2.0f - (m.a * centerX_ + m.c * centerY_);
+    m.ty = height_ / 2.0f - (m.b * centerX_ + m.d * centerY_);
     
-    // Apply rotation if non-zero
-    if (rotation_ != 0.0f) {
-        float cosAngle = std::cos(-rotation_);
-        float sinAngle = std::sin(-rotation_);
-        float rotatedX = relativeX * cosAngle - relativeY * sinAngle;
-        float rotatedY = relativeX * sinAngle + relativeY * cosAngle;
-        relativeX = rotatedX;
-        relativeY = rotatedY;
+    Transform& inv = screenToWorld_;
+    float det = m.a * m.d - m.b * m.c;
+    float invDet = det != 0.0f ? 1.0f / det : 0.0f;
+    inv.a = m.d * invDet;
+    inv.b = -m.b * invDet;
+    inv.c = -m.c * invDet;
+    inv.d = m.a * invDet;
+    inv.tx = -(inv.a * m.tx + inv.c * m.ty);
+    inv.ty = -(inv.b * m.tx + inv.d * m.ty);
+}
+
+void View::worldToScreen(float worldX, float worldY, int& screenX, int& screenY) const {
+    float x, y;
+    worldToScreen(worldX, worldY, x, y);
+    screenX = static_cast<int>(x);
+    screenY = static_cast<int>(y);
+}
+
+void View::worldToScreen(float worldX, float worldY, float& screenX, float& screenY) const {
+    const Transform& m = worldToScreen_;
+    screenX = m.a * worldX + m.c * worldY + m.tx;
+    screenY = m.b * worldX + m.d * worldY + m.ty;
+}
+
+void View::worldToScreen(const float* worldXY, float* screenXY, size_t count) const {
+    const Transform& m = worldToScreen_;
+    size_t i = 0;
+#if defined(VIEW_USE_SSE)
+    // Two points per register: [x0 y0 x1 y1] -> x*[a b a b] + y*[c d c d] + [tx ty tx ty]
+    const __m128 colX = _mm_setr_ps(m.a, m.b, m.a, m.b);
+    const __m128 colY = _mm_setr_ps(m.c, m.d, m.c, m.d);
+    const __m128 offset = _mm_setr_ps(m.tx, m.ty, m.tx, m.ty);
+    for (; i + 2 <= count; i += 2) {
+        __m128 points = _mm_loadu_ps(worldXY + 2 * i);
+        __m128 xs = _mm_shuffle_ps(points, points, _MM_SHUFFLE(2, 2, 0, 0));
+        __m128 ys = _mm_shuffle_ps(points, points, _MM_SHUFFLE(3, 3, 1, 1));
+        __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xs, colX), _mm_mul_ps(ys, colY)), offset);
+        _mm_storeu_ps(screenXY + 2 * i, result);
     }
-    
-    // Apply scale
-    relativeX *= scale_;
-    relativeY *= scale_;
-    
-    // Convert to screen coordinates (center on screen)
-    screenX = static_cast<int>(relativeX + width_ / 2.0f);
-    screenY = static_cast<int>(relativeY + height_ / 2.0f);
+#endif
+    for (; i < count; i++) {
+        float x = worldXY[2 * i];
+        float y = worldXY[2 * i + 1];
+        screenXY[2 * i] = m.a * x + m.c * y + m.tx;
+        screenXY[2 * i + 1] = m.b * x + m.d * y + m.ty;
+    }
+}
+
+void View::screenToWorld(float screenX, float screenY, float& worldX, float& worldY) const {
+    const Transform& inv = screenToWorld_;
+    worldX = inv.a * screenX + inv.c * screenY + inv.tx;
+    worldY = inv.b * screenX + inv.d * screenY + inv.ty;
+}
+
+void View::getWorldBounds(float& minX, float& minY, float& maxX, float& maxY) const {
+    // The screen rectangle's half extents mapped back through the inverse matrix
+    const Transform& inv = screenToWorld_;
+    float halfW = width_ / 2.0f;
+    float halfH = height_ / 2.0f;
+    float extentX = std::abs(inv.a) * halfW + std::abs(inv.c) * halfH;
+    float extentY = std::abs(inv.b) * halfW + std::abs(inv.d) * halfH;
+    minX = centerX_ - extentX;
+    minY = centerY_ - extentY;
+    maxX = centerX_ + extentX;
+    maxY = centerY_ + extentY;
 }
 
 void View::setCenter(float x, float y) {
@@ -37,11 +99,23 @@ void View::setCenter(float x, float y) {
     if (hasBounds_) {
         clampToBounds();
     }
+    updateTransform();
 }
 
 void View::setSize(float width, float height) {
     width_ = width;
     height_ = height;
+    updateTransform();
+}
+
+void View::setScale(float scale) {
+    scale_ = scale;
+    updateTransform();
+}
+
+void View::setRotation(float rotation) {
+    rotation_ = rotation;
+    updateTransform();
 }
 
 void View::move(float dx, float dy) {
@@ -51,6 +125,7 @@ void View::move(float dx, float dy) {
     if (hasBounds_) {
         clampToBounds();
     }
+    updateTransform();
 }
 
 void View::followTarget(float targetX, float targetY, float smoothing) {
@@ -64,6 +139,7 @@ void View::followTarget(float targetX, float targetY, float smoothing) {
     if (hasBounds_) {
         clampToBounds();
     }
+    updateTransform();
 }
 
 void View::setBounds(float minX, float minY, float maxX, float maxY) {
@@ -82,4 +158,5 @@ void View::clampToBounds() {
     
     centerX_ = std::max(minX_ + halfWidth, std::min(centerX_, maxX_ - halfWidth));
     centerY_ = std::max(minY_ + halfHeight, std::min(centerY_, maxY_ - halfHeight));
+    updateTransform();
 }
@@ -1,11 +1,34 @@
 #pragma once
+#include <cstddef>
 
 class View {
 public:
+    // 2x3 affine transform: x' = a*x + c*y + tx, y' = b*x + d*y + ty
+    struct Transform {
+        float a = 1.0f, b = 0.0f;
+        float c = 0.0f, d = 1.0f;
+        float tx = 0.0f, ty = 0.0f;
+    };
+
     View(float x = 0.0f, float y = 0.0f, float width = 800.0f, float height = 600.0f);
 
     // Transform world coordinates to screen coordinates
     void worldToScreen(float worldX, float worldY, int& screenX, int& screenY) const;
+    void worldToScreen(float worldX, float worldY, float& screenX, float& screenY) const;
+    
+    // Transform `count` interleaved x,y pairs in one pass (SIMD where available).
+    // `worldXY` and `screenXY` may be the same array.
+    void worldToScreen(const float* worldXY, float* screenXY, size_t count) const;
+    
+    // Inverse transform, for picking
+    void screenToWorld(float screenX, float screenY, float& worldX, float& worldY) const;
+    
+    // Cached matrices, rebuilt whenever center, size, scale or rotation change
+    const Transform& getTransform() const { return worldToScreen_; }
+    const Transform& getInverseTransform() const { return screenToWorld_; }
+    
+    // World-space box containing everything the view can see (rotation included)
+    void getWorldBounds(float& minX, float& minY, float& maxX, float& maxY) const;
     
     // Getters
     float getCenterX() const { return centerX_; }
@@ -18,8 +41,8 @@ public:
     // Setters
     void setCenter(float x, float y);
     void setSize(float width, float height);
-    void setScale(float scale) { scale_ = scale; }
-    void setRotation(float rotation) { rotation_ = rotation; }
+    void setScale(float scale);
+    void setRotation(float rotation);
     
     // Camera movement
     void move(float dx, float dy);
@@ -30,6 +53,8 @@ public:
     void clampToBounds();
 
 private:
+    void updateTransform();
+    
     float centerX_;
     float centerY_;
     float width_;
@@ -37,6 +62,9 @@ private:
     float scale_ = 1.0f;
     float rotation_ = 0.0f;  // In radians
     
+    Transform worldToScreen_;
+    Transform screenToWorld_;
+    
     // Optional bounds
     bool hasBounds_ = false;
     float minX_, minY_, maxX_, maxY_;
@@ -1,7 +1,25 @@
 #include "Game.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
 
-int main(int argc, char* argv[]) 
+// Usage: demo [--headless] [--frames N] [--font path.ttf]
+int main(int argc, char* argv[])
 {
+    Game::LaunchOptions options;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            options.headless = true;
+        } else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            options.maxFrames = std::atoll(argv[++i]);
+        } else if (std::strcmp(argv[i], "--font") == 0 && i + 1 < argc) {
+            options.fontPath = argv[++i];
+        } else {
+            std::cerr << "usage: " << argv[0] << " [--headless] [--frames N] [--font path.ttf]\n";
+            return 1;
+        }
+    }
+
     Game game;
-    return game.run();
+    return game.run(options);
 }
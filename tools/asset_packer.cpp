@@ -0,0 +1,153 @@
+// Asset packer: turns the loose files in assets/ into assets.pak, so the game
+// starts without inflating PNGs or parsing XML. PNGs are decoded, reduced to
+// their display size (textures.xml) and packed into atlas pages exactly as
+// Graphics::buildAtlas would, then stored as raw ARGB8888 pages; config.xml
+// and objects.xml are stored as their binary records. See AssetArchive.h.
+//
+// Usage: asset_packer <assetDir> <output.pak>
+// The build runs it after copying assets next to the demo.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "AssetArchive.h"
+#include "GameConfig.h"
+#include "Graphics.h"
+#include "MipGenerator.h"
+#include "ObjectFactory.h"
+#include "Snapshot.h"
+#include "TextureAtlas.h"
+
+namespace {
+
+using Format = AssetArchiveFormat;
+
+// Same page limit Graphics::buildAtlas starts from; renderers that cannot
+// hold it fail the upload and the game falls back to the loose files
+constexpr int MAX_PAGE_SIZE = 2048;
+
+std::vector<uint8_t> encodePage(const TextureAtlas::PackedPage& page,
+                                const std::unordered_map<std::string, size_t>& sourceBytes) {
+    SDL_Surface* surface = page.surface;
+    Format::AtlasPageHeader header = {};
+    header.width = static_cast<uint32_t>(surface->w);
+    header.height = static_cast<uint32_t>(surface->h);
+    header.pitch = header.width * 4;  // Tight rows
+    header.format = SDL_PIXELFORMAT_ARGB8888;
+    header.regionCount = static_cast<uint32_t>(page.regions.size());
+    size_t pixelOffset = sizeof(header) + page.regions.size() * sizeof(Format::AtlasRegion);
+    pixelOffset = (pixelOffset + Format::ALIGNMENT - 1) / Format::ALIGNMENT * Format::ALIGNMENT;
+    header.pixelOffset = static_cast<uint32_t>(pixelOffset);
+
+    std::vector<uint8_t> payload;
+    SnapshotWriter writer(payload);
+    writer.write(header);
+    for (const TextureAtlas::PackedRegion& packed : page.regions) {
+        Format::AtlasRegion region = {};
+        std::strncpy(region.name, packed.name.c_str(), Format::NAME_SIZE - 1);
+        region.x = packed.rect.x;
+        region.y = packed.rect.y;
+        region.w = packed.rect.w;
+        region.h = packed.rect.h;
+        auto source = sourceBytes.find(packed.name);
+        region.sourceBytes = source != sourceBytes.end() ? static_cast<uint32_t>(source->second) : 0;
+        writer.write(region);
+    }
+    payload.resize(pixelOffset, 0);
+    for (int y = 0; y < surface->h; y++) {
+        writer.writeArray(static_cast<const uint8_t*>(surface->pixels) + y * surface->pitch, header.pitch);
+    }
+    return payload;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::fprintf(stderr, "usage: %s <assetDir> <output.pak>\n", argv[0]);
+        return 1;
+    }
+    const std::filesystem::path assetDir = argv[1];
+    const std::string outputPath = argv[2];
+    auto start = std::chrono::steady_clock::now();
+    AssetArchiveWriter archive;
+    bool ok = true;
+
+    // Textures: decode, reduce and pack on the CPU, as at runtime
+    std::vector<Graphics::TextureDisplaySize> displaySizes;
+    Graphics::parseTextureManifest((assetDir / "textures.xml").string(), displaySizes);
+    std::vector<std::filesystem::path> images;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(assetDir, error)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".png") {
+            images.push_back(entry.path());
+        }
+    }
+    std::sort(images.begin(), images.end());  // Same archive for the same inputs
+
+    TextureAtlas atlas;
+    std::unordered_map<std::string, size_t> sourceBytes;
+    for (const std::filesystem::path& path : images) {
+        SDL_Surface* surface = Graphics::decodeImage(path.string());
+        if (!surface) {
+            ok = false;
+            continue;
+        }
+        std::string name = path.stem().string();
+        sourceBytes[name] = static_cast<size_t>(surface->w) * surface->h * 4;
+        for (const Graphics::TextureDisplaySize& size : displaySizes) {
+            if (size.name == name) {
+                surface = reduceToDisplaySize(surface, std::max(size.width, 1), std::max(size.height, 1));
+                break;
+            }
+        }
+        atlas.add(name, surface);
+    }
+    std::vector<TextureAtlas::PackedPage> pages;
+    ok = atlas.pack(MAX_PAGE_SIZE, pages) && ok;
+    for (size_t p = 0; p < pages.size(); p++) {
+        archive.add("atlas" + std::to_string(p), Format::EntryType::AtlasPage, encodePage(pages[p], sourceBytes));
+        std::printf("  atlas page %zu: %dx%d, %zu images\n", p, pages[p].surface->w, pages[p].surface->h,
+                    pages[p].regions.size());
+        SDL_FreeSurface(pages[p].surface);
+    }
+
+    // Config and object definitions as binary records
+    GameConfig config;
+    if (config.loadXML((assetDir / "config.xml").string())) {
+        std::vector<uint8_t> payload;
+        SnapshotWriter writer(payload);
+        config.write(writer);
+        archive.add("config.xml", Format::EntryType::Config, payload);
+    } else {
+        ok = false;
+    }
+    std::vector<ObjectDefinition> definitions;
+    if (ObjectFactory::parseXML((assetDir / "objects.xml").string(), definitions)) {
+        std::vector<uint8_t> payload;
+        SnapshotWriter writer(payload);
+        ObjectFactory::writeBinary(writer, definitions);
+        archive.add("objects.xml", Format::EntryType::ObjectDefinitions, payload);
+    } else {
+        ok = false;
+    }
+
+    if (!ok) {
+        std::fprintf(stderr, "asset_packer: some assets failed; not writing %s\n", outputPath.c_str());
+        std::filesystem::remove(outputPath, error);  // Never leave a stale archive behind
+        return 1;
+    }
+    if (!archive.write(outputPath)) {
+        return 1;
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::printf("asset_packer: %zu images, %zu entries -> %s (%llu KB) in %.1f ms\n", images.size(),
+                archive.getEntryCount(), outputPath.c_str(),
+                static_cast<unsigned long long>(std::filesystem::file_size(outputPath, error) / 1024), ms);
+    return 0;
+}